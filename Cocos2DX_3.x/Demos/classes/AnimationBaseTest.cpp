@@ -102,5 +102,5 @@ void AnimationBaseTest::_animationEventHandler(cocos2d::EventCustom* event) cons
 {
     const auto eventObject = (dragonBones::EventObject*)event->getUserData();
 
-    cocos2d::log("%s %s %s", eventObject->animationState->getName().c_str(), eventObject->type.c_str(), eventObject->name.c_str());
+    cocos2d::log("%s %s %s", eventObject->animationState->getName().c_str(), dragonBones::EventObject::getTypeName(eventObject->type).c_str(), eventObject->getName().c_str());
 }
\ No newline at end of file
@@ -364,7 +364,7 @@ void Mecha::aim(const cocos2d::Vec2& target)
 void Mecha::_animationEventHandler(cocos2d::EventCustom * event)
 {
     const auto eventObject = (dragonBones::EventObject*)event->getUserData();
-    if (eventObject->type == dragonBones::EventObject::FADE_IN_COMPLETE)
+    if (eventObject->type == dragonBones::EventObjectType::FadeInComplete)
     {
         if (eventObject->animationState->getName() == "jump_1")
         {
@@ -377,7 +377,7 @@ void Mecha::_animationEventHandler(cocos2d::EventCustom * event)
             _updateAnimation();
         }
     }
-    else if (eventObject->type == dragonBones::EventObject::FADE_OUT_COMPLETE)
+    else if (eventObject->type == dragonBones::EventObjectType::FadeOutComplete)
     {
         if (eventObject->animationState->getName() == "attack_01")
         {
@@ -390,7 +390,7 @@ void Mecha::_animationEventHandler(cocos2d::EventCustom * event)
 void Mecha::_frameEventHandler(cocos2d::EventCustom* event)
 {
     const auto eventObject = (dragonBones::EventObject*)event->getUserData();
-    if (eventObject->name == "onFire")
+    if (eventObject->getName() == "onFire")
     {
         const auto display = (dragonBones::CCArmatureDisplayContainer*)eventObject->armature->getDisplay();
         const auto firePointBone = eventObject->armature->getBone("firePoint");
@@ -322,21 +322,21 @@ void Hero::_armEventHandler(cocos2d::EventCustom* event)
 {
     const auto eventObject = (dragonBones::EventObject*)event->getUserData();
 
-    if (eventObject->type == dragonBones::EventObject::COMPLETE)
+    if (eventObject->type == dragonBones::EventObjectType::Complete)
     {
         _isAttacking = false;
         _hitCount = 0;
         const auto animationName = "ready_" + _weaponName;
         _armArmature->getAnimation().fadeIn(animationName);
     }
-    else if (eventObject->type == dragonBones::EventObject::FRAME_EVENT)
+    else if (eventObject->type == dragonBones::EventObjectType::Frame)
     {
-        if (eventObject->name == "ready")
+        if (eventObject->getName() == "ready")
         {
             _isAttacking = false;
             _hitCount++;
         }
-        else if (eventObject->name == "fire")
+        else if (eventObject->getName() == "fire")
         {
             const auto display = (dragonBones::CCArmatureDisplayContainer*)(eventObject->armature->getDisplay());
             const auto firePointBone = eventObject->armature->getBone("bow");
@@ -0,0 +1,159 @@
+#include "CCArmatureBatchDisplay.h"
+#include "CCTextureData.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+CCArmatureBatchDisplay* CCArmatureBatchDisplay::create()
+{
+    CCArmatureBatchDisplay* displayContainer = new (std::nothrow) CCArmatureBatchDisplay();
+
+    if (displayContainer && displayContainer->init())
+    {
+        displayContainer->autorelease();
+    }
+    else
+    {
+        CC_SAFE_DELETE(displayContainer);
+    }
+
+    return displayContainer;
+}
+
+CCArmatureBatchDisplay::CCArmatureBatchDisplay() :
+    _crowd(nullptr),
+    _drawFrame(0),
+    _drawCount(0),
+    _drawBuffers()
+{
+}
+CCArmatureBatchDisplay::~CCArmatureBatchDisplay()
+{
+    for (const auto drawBuffers : _drawBuffers)
+    {
+        delete drawBuffers;
+    }
+
+    _drawBuffers.clear();
+}
+
+bool CCArmatureBatchDisplay::init()
+{
+    if (!CCArmatureDisplayContainer::init())
+    {
+        return false;
+    }
+
+    this->setGLProgramState(cocos2d::GLProgramState::getOrCreateWithGLProgramName(cocos2d::GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP));
+
+    return true;
+}
+
+CCArmatureBatchDisplay::DrawBuffers& CCArmatureBatchDisplay::_getDrawBuffers()
+{
+    const auto frame = cocos2d::Director::getInstance()->getTotalFrames();
+    if (_drawFrame != frame)
+    {
+        _drawFrame = frame;
+        _drawCount = 0;
+    }
+
+    if (_drawBuffers.size() <= _drawCount)
+    {
+        _drawBuffers.push_back(new DrawBuffers());
+    }
+
+    return *_drawBuffers[_drawCount++];
+}
+
+void CCArmatureBatchDisplay::_addCommands(cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t flags, DrawBuffers& drawBuffers)
+{
+    const auto& batches = drawBuffers.batchBuilder.batches;
+    const auto& batchVertices = drawBuffers.batchBuilder.vertices;
+    const auto replaceTexture = _armature ? static_cast<cocos2d::Texture2D*>(_armature->_replaceTexture) : nullptr;
+    const auto& color = this->getDisplayedColor();
+    const auto opacity = this->getDisplayedOpacity();
+    auto& vertices = drawBuffers.vertices;
+    auto& commands = drawBuffers.commands;
+
+    vertices.resize(batchVertices.size());
+
+    // Commands keep pointers into vertices and commands until the renderer flushes, so both are sized before any command is added.
+    if (commands.size() < batches.size())
+    {
+        commands.resize(batches.size());
+    }
+
+    for (std::size_t i = 0, l = batches.size(); i < l; ++i)
+    {
+        const auto& batch = batches[i];
+        const auto texture = replaceTexture && batch.armature ? replaceTexture : static_cast<CCTextureAtlasData*>(batch.textureAtlas)->texture;
+        if (!texture || batch.indexCount == 0)
+        {
+            continue;
+        }
+
+        const auto& textureSize = texture->getContentSizeInPixels();
+        for (std::size_t iV = batch.vertexStart, lV = batch.vertexStart + batch.vertexCount; iV < lV; ++iV)
+        {
+            const auto& batchVertex = batchVertices[iV];
+            auto& vertex = vertices[iV];
+
+            vertex.vertices.set(batchVertex.x, -batchVertex.y, 0.f);
+            vertex.texCoords.u = batchVertex.u / textureSize.width;
+            vertex.texCoords.v = batchVertex.v / textureSize.height;
+            vertex.colors.r = (GLubyte)(batchVertex.r * color.r / 255);
+            vertex.colors.g = (GLubyte)(batchVertex.g * color.g / 255);
+            vertex.colors.b = (GLubyte)(batchVertex.b * color.b / 255);
+            vertex.colors.a = (GLubyte)(batchVertex.a * opacity / 255);
+        }
+
+        cocos2d::BlendFunc blendFunc = texture->hasPremultipliedAlpha() ? cocos2d::BlendFunc::ALPHA_PREMULTIPLIED : cocos2d::BlendFunc::ALPHA_NON_PREMULTIPLIED;
+        if (batch.blendMode == BlendMode::Add)
+        {
+            if (texture->hasPremultipliedAlpha())
+            {
+                blendFunc = { GL_ONE, GL_ONE };
+            }
+            else
+            {
+                blendFunc = cocos2d::BlendFunc::ADDITIVE;
+            }
+        }
+
+        cocos2d::TrianglesCommand::Triangles triangles;
+        triangles.verts = &vertices[batch.vertexStart];
+        triangles.indices = const_cast<unsigned short*>(&drawBuffers.batchBuilder.indices[batch.indexStart]);
+        triangles.vertCount = batch.vertexCount;
+        triangles.indexCount = batch.indexCount;
+
+        auto& command = commands[i];
+        command.init(_globalZOrder, texture->getName(), this->getGLProgramState(), blendFunc, triangles, transform, flags);
+        renderer->addCommand(&command);
+    }
+}
+
+void CCArmatureBatchDisplay::draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t flags)
+{
+    if (!_armature && !_crowd)
+    {
+        return;
+    }
+
+    static const Matrix identityMatrix;
+    auto& drawBuffers = _getDrawBuffers();
+    drawBuffers.batchBuilder.clear();
+
+    if (_armature)
+    {
+        drawBuffers.batchBuilder.addArmature(*_armature, identityMatrix);
+    }
+
+    if (_crowd)
+    {
+        drawBuffers.batchBuilder.addCrowd(*_crowd, identityMatrix);
+    }
+
+    _addCommands(renderer, transform, flags, drawBuffers);
+}
+
+DRAGONBONES_NAMESPACE_END
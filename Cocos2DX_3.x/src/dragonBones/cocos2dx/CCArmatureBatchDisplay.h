@@ -0,0 +1,64 @@
+#ifndef DRAGONBONES_CC_ARMATURE_BATCH_DISPLAY_H
+#define DRAGONBONES_CC_ARMATURE_BATCH_DISPLAY_H
+
+#include "CCArmatureDisplayContainer.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+/**
+ * Display container without per slot child nodes, draws the whole armature with one TrianglesCommand per texture and blend run.
+ * It draws a Crowd after the armature when one is set, create() without an armature draws only the crowd.
+ */
+class CCArmatureBatchDisplay : public CCArmatureDisplayContainer
+{
+public:
+    /** @private */
+    static CCArmatureBatchDisplay* create();
+
+protected:
+    /**
+     * Buffers of one draw(). Queued commands point into them until the renderer flushes at the end of the frame,
+     * so a display drawn more than once per frame (render textures, several cameras) takes one set per draw().
+     */
+    class DrawBuffers final
+    {
+    public:
+        RenderBatchBuilder batchBuilder;
+        std::vector<cocos2d::V3F_C4B_T2F> vertices;
+        std::vector<cocos2d::TrianglesCommand> commands;
+    };
+
+protected:
+    Crowd* _crowd;
+    unsigned _drawFrame;
+    std::size_t _drawCount;
+    std::vector<DrawBuffers*> _drawBuffers;
+
+protected:
+    CCArmatureBatchDisplay();
+    virtual ~CCArmatureBatchDisplay();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(CCArmatureBatchDisplay);
+
+protected:
+    DrawBuffers& _getDrawBuffers();
+    void _addCommands(cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t flags, DrawBuffers& drawBuffers);
+
+public:
+    virtual bool init() override;
+    virtual void draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t flags) override;
+
+    inline Crowd* getCrowd() const
+    {
+        return _crowd;
+    }
+    /** Not retained, the crowd is advanced by its owner (e.g. added to a WorldClock) and must outlive the display or be unset first. */
+    inline void setCrowd(Crowd* value)
+    {
+        _crowd = value;
+    }
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_CC_ARMATURE_BATCH_DISPLAY_H
@@ -38,7 +38,26 @@ void CCArmatureDisplayContainer::_onClear()
 
 void CCArmatureDisplayContainer::_dispatchEvent(EventObject* value)
 {
-    _dispatcher.dispatchCustomEvent(value->type, value);
+    _dispatcher.dispatchCustomEvent(EventObject::getTypeName(value->type), value);
+}
+
+unsigned CCArmatureDisplayContainer::getEventMask() const
+{
+    if (!_dispatcher.isEnabled())
+    {
+        return 0;
+    }
+
+    unsigned mask = 0;
+    for (unsigned i = 0; i < EventObject::TYPE_COUNT; ++i)
+    {
+        if (_dispatcher.hasEventListener(EventObject::getTypeName((EventObjectType)i)))
+        {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
 }
 
 void CCArmatureDisplayContainer::update(float passedTime)
@@ -74,8 +93,11 @@ DBCCSprite* DBCCSprite::create()
     return sprite;
 }
 
-DBCCSprite::DBCCSprite()
+DBCCSprite::DBCCSprite() :
+    _meshTriangles(),
+    _meshRect()
 {
+    clearMesh();
 }
 DBCCSprite::~DBCCSprite() {}
 
@@ -147,8 +169,10 @@ bool DBCCSprite::_checkVisibility(const cocos2d::Mat4& transform, const cocos2d:
 
 void DBCCSprite::draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t flags)
 {
+    const auto& triangles = _meshTriangles.verts ? _meshTriangles : this->_polyInfo.triangles;
+
 #if CC_USE_CULLING
-    const auto& rect = this->_polyInfo.rect;
+    const auto& rect = _meshTriangles.verts ? _meshRect : this->_polyInfo.rect;
 
 
 
@@ -176,14 +200,14 @@ void DBCCSprite::draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& transfor
     if (_insideBounds)
 #endif
     {
-        _trianglesCommand.init(_globalZOrder, _texture->getName(), getGLProgramState(), _blendFunc, _polyInfo.triangles, transform, flags);
+        _trianglesCommand.init(_globalZOrder, _texture->getName(), getGLProgramState(), _blendFunc, triangles, transform, flags);
         renderer->addCommand(&_trianglesCommand);
 
 #if CC_SPRITE_DEBUG_DRAW
         _debugDrawNode->clear();
-        auto count = _polyInfo.triangles.indexCount / 3;
-        auto indices = _polyInfo.triangles.indices;
-        auto verts = _polyInfo.triangles.verts;
+        auto count = triangles.indexCount / 3;
+        auto indices = triangles.indices;
+        auto verts = triangles.verts;
         for (ssize_t i = 0; i < count; i++)
         {
             //draw 3 lines
@@ -208,4 +232,44 @@ cocos2d::PolygonInfo& DBCCSprite::getPolygonInfoModify()
     return this->_polyInfo;
 }
 
+void DBCCSprite::setMesh(cocos2d::V3F_C4B_T2F* verts, unsigned vertCount, const unsigned short* indices, unsigned indexCount, const cocos2d::Rect& rect)
+{
+    _meshTriangles.verts = verts;
+    _meshTriangles.indices = const_cast<unsigned short*>(indices); // Shared by every instance of the mesh
+    _meshTriangles.vertCount = vertCount;
+    _meshTriangles.indexCount = indexCount;
+    _meshRect = rect; // copy
+
+    updateColor();
+}
+
+void DBCCSprite::clearMesh()
+{
+    _meshTriangles.verts = nullptr;
+    _meshTriangles.indices = nullptr;
+    _meshTriangles.vertCount = 0;
+    _meshTriangles.indexCount = 0;
+}
+
+void DBCCSprite::updateColor()
+{
+    cocos2d::Sprite::updateColor();
+
+    if (_meshTriangles.verts)
+    {
+        cocos2d::Color4B color4(_displayedColor.r, _displayedColor.g, _displayedColor.b, _displayedOpacity);
+        if (_opacityModifyRGB)
+        {
+            color4.r *= _displayedOpacity / 255.f;
+            color4.g *= _displayedOpacity / 255.f;
+            color4.b *= _displayedOpacity / 255.f;
+        }
+
+        for (std::size_t i = 0, l = _meshTriangles.vertCount; i < l; ++i)
+        {
+            _meshTriangles.verts[i].colors = color4;
+        }
+    }
+}
+
 DRAGONBONES_NAMESPACE_END
\ No newline at end of file
@@ -42,6 +42,8 @@ public:
         return _dispatcher.isEnabled();
     }
 
+    unsigned getEventMask() const override;
+
     inline Armature* getArmature() const override 
     {
         return _armature;
@@ -67,11 +69,18 @@ protected:
 private:
     DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(DBCCSprite);
 
+    /** Mesh drawn in place of the sprite polygon, not copied, see setMesh(). */
+    cocos2d::TrianglesCommand::Triangles _meshTriangles;
+    cocos2d::Rect _meshRect;
+
     /**
     * Modify for polyInfo rect
     */
     bool _checkVisibility(const cocos2d::Mat4& transform, const cocos2d::Size& size, const cocos2d::Rect& rect);
 
+protected:
+    virtual void updateColor() override;
+
 public:
     /**
      * Modify for polyInfo rect
@@ -81,6 +90,19 @@ public:
      * Modify for cocos2dx 3.7, 3.8, 3.9
      */
     cocos2d::PolygonInfo& getPolygonInfoModify();
+    /**
+     * @private Draws verts and indices instead of the sprite polygon, the sprite color is applied to verts.
+     * Neither buffer is copied, both have to stay valid until the next setMesh() or clearMesh().
+     */
+    void setMesh(cocos2d::V3F_C4B_T2F* verts, unsigned vertCount, const unsigned short* indices, unsigned indexCount, const cocos2d::Rect& rect);
+    /** @private */
+    void clearMesh();
+
+    /** @private Culling rect of the mesh after its vertices moved. */
+    inline void setMeshRect(const cocos2d::Rect& rect)
+    {
+        _meshRect = rect;
+    }
 };
 
 DRAGONBONES_NAMESPACE_END
@@ -3,6 +3,7 @@
 
 #include "CCTextureData.h"
 #include "CCArmatureDisplayContainer.h"
+#include "CCArmatureBatchDisplay.h"
 #include "CCSlot.h"
 #include "CCFactory.h"
 
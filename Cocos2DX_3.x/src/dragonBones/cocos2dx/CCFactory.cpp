@@ -5,7 +5,8 @@
 
 DRAGONBONES_NAMESPACE_BEGIN
 
-CCFactory::CCFactory() 
+CCFactory::CCFactory() :
+    _isBuildingBatch(false)
 {
 }
 CCFactory::~CCFactory() 
@@ -30,7 +31,7 @@ TextureAtlasData * CCFactory::_generateTextureAtlasData(TextureAtlasData* textur
 Armature * CCFactory::_generateArmature(const BuildArmaturePackage & dataPackage) const
 {
     const auto armature = BaseObject::borrowObject<Armature>();
-    const auto armatureDisplayContainer = CCArmatureDisplayContainer::create();
+    const auto armatureDisplayContainer = _isBuildingBatch ? CCArmatureBatchDisplay::create() : CCArmatureDisplayContainer::create();
 
     armature->_armatureData = dataPackage.armature;
     armature->_skinData = dataPackage.skin;
@@ -50,6 +51,11 @@ Armature * CCFactory::_generateArmature(const BuildArmaturePackage & dataPackage
 
 Slot * CCFactory::_generateSlot(const BuildArmaturePackage& dataPackage, const SlotDisplayDataSet& slotDisplayDataSet) const
 {
+    if (_isBuildingBatch)
+    {
+        return _generateBatchSlot(dataPackage, slotDisplayDataSet);
+    }
+
     const auto slot = BaseObject::borrowObject<CCSlot>();
     const auto slotData = slotDisplayDataSet.slot;
     std::vector<std::pair<void*, DisplayType>> displayList;
@@ -111,6 +117,54 @@ Slot * CCFactory::_generateSlot(const BuildArmaturePackage& dataPackage, const S
     return slot;
 }
 
+Slot* CCFactory::_generateBatchSlot(const BuildArmaturePackage& dataPackage, const SlotDisplayDataSet& slotDisplayDataSet) const
+{
+    const auto slot = BaseObject::borrowObject<CCBatchSlot>();
+    std::vector<std::pair<void*, DisplayType>> displayList;
+
+    slot->name = slotDisplayDataSet.slot->name;
+    slot->_rawDisplay = slot; // No render display, any non null value marks the display as shown.
+    slot->_meshDisplay = slot;
+
+    displayList.reserve(slotDisplayDataSet.displays.size());
+
+    for (const auto displayData : slotDisplayDataSet.displays)
+    {
+        switch (displayData->type)
+        {
+            case DisplayType::Image:
+            case DisplayType::Mesh:
+                if (!displayData->textureData)
+                {
+                    displayData->textureData = this->_getTextureData(dataPackage.dataName, displayData->name);
+                }
+
+                displayList.push_back(std::make_pair(slot, displayData->type));
+                break;
+
+            case DisplayType::Armature:
+            {
+                const auto childArmature = buildArmature(displayData->name, dataPackage.dataName);
+                if (childArmature)
+                {
+                    childArmature->getAnimation().play();
+                }
+
+                displayList.push_back(std::make_pair(childArmature, DisplayType::Armature));
+                break;
+            }
+
+            default:
+                displayList.push_back(std::make_pair(nullptr, DisplayType::Image));
+                break;
+        }
+    }
+
+    slot->_setDisplayList(displayList);
+
+    return slot;
+}
+
 DragonBonesData* CCFactory::loadDragonBonesData(const std::string& filePath, const std::string& dragonBonesName)
 {
     if (!dragonBonesName.empty())
@@ -210,4 +264,19 @@ CCArmatureDisplayContainer * CCFactory::buildArmatureDisplay(const std::string&
     return armatureDisplay;
 }
 
+CCArmatureBatchDisplay* CCFactory::buildArmatureBatchDisplay(const std::string& armatureName, const std::string& dragonBonesName, const std::string& skinName) const
+{
+    _isBuildingBatch = true;
+    const auto armature = this->buildArmature(armatureName, dragonBonesName, skinName);
+    _isBuildingBatch = false;
+
+    const auto armatureDisplay = armature ? static_cast<CCArmatureBatchDisplay*>(armature->_display) : nullptr;
+    if (armatureDisplay)
+    {
+        armatureDisplay->advanceTimeBySelf(true);
+    }
+
+    return armatureDisplay;
+}
+
 DRAGONBONES_NAMESPACE_END
\ No newline at end of file
@@ -4,11 +4,16 @@
 #include "dragonBones/DragonBonesHeaders.h"
 #include "cocos2d.h"
 #include "CCArmatureDisplayContainer.h"
+#include "CCArmatureBatchDisplay.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
 class CCFactory : public BaseFactory
 {
+protected:
+    /** Set while buildArmatureBatchDisplay runs, so child armatures are built the same way. */
+    mutable bool _isBuildingBatch;
+
 public:
     CCFactory();
     ~CCFactory();
@@ -20,11 +25,14 @@ protected:
     virtual TextureAtlasData* _generateTextureAtlasData(TextureAtlasData* textureAtlasData, void* textureAtlas) const override;
     virtual Armature* _generateArmature(const BuildArmaturePackage& dataPackage) const override;
     virtual Slot* _generateSlot(const BuildArmaturePackage& dataPackage, const SlotDisplayDataSet& slotDisplayDataSet) const override;
+    Slot* _generateBatchSlot(const BuildArmaturePackage& dataPackage, const SlotDisplayDataSet& slotDisplayDataSet) const;
 
 public:
     virtual DragonBonesData* loadDragonBonesData(const std::string& filePath, const std::string& dragonBonesName = "");
     virtual TextureAtlasData* loadTextureAtlasData(const std::string& filePath, const std::string& dragonBonesName = "", float scale = 0.f);
     virtual CCArmatureDisplayContainer* buildArmatureDisplay(const std::string& armatureName, const std::string& dragonBonesName = "", const std::string& skinName = "") const;
+    /** Same as buildArmatureDisplay, but the armature is drawn by a single node without per slot child nodes. */
+    virtual CCArmatureBatchDisplay* buildArmatureBatchDisplay(const std::string& armatureName, const std::string& dragonBonesName = "", const std::string& skinName = "") const;
 };
 
 DRAGONBONES_NAMESPACE_END
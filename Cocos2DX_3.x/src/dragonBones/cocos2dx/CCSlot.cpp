@@ -17,7 +17,10 @@ void CCSlot::_onClear()
 {
     Slot::_onClear();
 
+    _deformedBegin = 0;
+    _deformedEnd = 0;
     _renderDisplay = nullptr;
+    _meshVertices.clear();
 }
 
 void CCSlot::_initDisplay(void* value)
@@ -176,8 +179,7 @@ void CCSlot::_updateFrame()
                 {
                     const auto& region = currentTextureData->region;
                     const auto& textureAtlasSize = currentTextureData->texture->getTexture()->getContentSizeInPixels();
-                    auto displayVertices = new cocos2d::V3F_C4B_T2F[(unsigned)(this->_meshData->uvs.size() / 2)]; // does cocos2dx release it?
-                    auto vertexIndices = new unsigned short[this->_meshData->vertexIndices.size()]; // does cocos2dx release it?
+                    _meshVertices.resize(this->_meshData->uvs.size() / 2);
                     cocos2d::Rect boundsRect(999999.f, 999999.f, -999999.f, -999999.f);
 
                     for (std::size_t i = 0, l = this->_meshData->uvs.size(); i < l; i += 2)
@@ -185,12 +187,10 @@ void CCSlot::_updateFrame()
                         const auto iH = (unsigned)(i / 2);
                         const auto x = this->_meshData->vertices[i];
                         const auto y = this->_meshData->vertices[i + 1];
-                        cocos2d::V3F_C4B_T2F vertexData;
+                        auto& vertexData = _meshVertices[iH];
                         vertexData.vertices.set(x, -y, 0.f);
                         vertexData.texCoords.u = (region.x + this->_meshData->uvs[i] * region.width) / textureAtlasSize.width;
                         vertexData.texCoords.v = (region.y + this->_meshData->uvs[i + 1] * region.height) / textureAtlasSize.height;
-                        vertexData.colors = cocos2d::Color4B::WHITE;
-                        displayVertices[iH] = vertexData;
 
                         if (boundsRect.origin.x > x)
                         {
@@ -216,10 +216,8 @@ void CCSlot::_updateFrame()
                     boundsRect.size.width -= boundsRect.origin.x;
                     boundsRect.size.height -= boundsRect.origin.y;
 
-                    for (std::size_t i = 0, l = this->_meshData->vertexIndices.size(); i < l; ++i)
-                    {
-                        vertexIndices[i] = this->_meshData->vertexIndices[i];
-                    }
+                    _deformedBegin = 0;
+                    _deformedEnd = 0;
 
                     // In cocos2dx render meshDisplay and frameDisplay are the same display
                     frameDisplay->setSpriteFrame(currentTextureData->texture); // polygonInfo will be override
@@ -228,15 +226,12 @@ void CCSlot::_updateFrame()
                         frameDisplay->setTexture(currentTexture); // Relpace texture // polygonInfo will be override
                     }
 
-                    //
-                    cocos2d::PolygonInfo polygonInfo;
-                    auto& triangles = polygonInfo.triangles;
-                    triangles.verts = displayVertices;
-                    triangles.indices = vertexIndices;
-                    triangles.vertCount = (unsigned)(this->_meshData->uvs.size() / 2);
-                    triangles.indexCount = (unsigned)(this->_meshData->vertexIndices.size());
-                    polygonInfo.rect = boundsRect; // Copy
-                    frameDisplay->setPolygonInfo(polygonInfo);
+                    // Drawn in place, the indices are shared by every instance of the mesh.
+                    frameDisplay->setMesh(
+                        _meshVertices.data(), (unsigned)_meshVertices.size(),
+                        this->_meshData->vertexIndices.data(), (unsigned)this->_meshData->vertexIndices.size(),
+                        boundsRect
+                    );
                     frameDisplay->setContentSize(boundsRect.size);
 
                     if (this->_meshData->skinned)
@@ -283,6 +278,7 @@ void CCSlot::_updateFrame()
                     pivot.x = pivot.x / currentTextureData->region.width;
                     pivot.y = 1.f - pivot.y / currentTextureData->region.height;
 
+                    frameDisplay->clearMesh();
                     frameDisplay->setSpriteFrame(currentTextureData->texture); // polygonInfo will be override
 
                     if (currentTexture != currentTextureData->texture->getTexture())
@@ -300,6 +296,7 @@ void CCSlot::_updateFrame()
         }
     }
 
+    frameDisplay->clearMesh();
     frameDisplay->setTexture(nullptr);
     frameDisplay->setTextureRect(cocos2d::Rect::ZERO);
     frameDisplay->setAnchorPoint(cocos2d::Vec2::ZERO);
@@ -311,84 +308,53 @@ void CCSlot::_updateMesh()
     const auto meshDisplay = static_cast<DBCCSprite*>(this->_meshDisplay);
     const auto hasFFD = !this->_ffdVertices.empty();
 
-    const auto displayVertices = meshDisplay->getPolygonInfoModify().triangles.verts;
+    const auto displayVertices = _meshVertices.data();
     cocos2d::Rect boundsRect(999999.f, 999999.f, -999999.f, -999999.f);
 
     if (this->_meshData->skinned)
     {
-        std::size_t iF = 0;
-        for (std::size_t i = 0, l = this->_meshData->vertices.size(); i < l; i += 2)
-        {
-            const auto iH = unsigned(i / 2);
-
-            const auto& boneIndices = this->_meshData->boneIndices[iH];
-            const auto& boneVertices = this->_meshData->boneVertices[iH];
-            const auto& weights = this->_meshData->weights[iH];
-
-            float xG = 0.f, yG = 0.f;
-            for (std::size_t iB = 0, lB = boneIndices.size(); iB < lB; ++iB)
-            {
-                const auto bone = this->_meshBones[boneIndices[iB]];
-                const auto matrix = bone->globalTransformMatrix;
-                const auto weight = weights[iB];
-
-                float xL = 0.f, yL = 0.f;
-                if (hasFFD)
-                {
-                    xL = boneVertices[iB * 2] + this->_ffdVertices[iF];
-                    yL = boneVertices[iB * 2 + 1] + this->_ffdVertices[iF + 1];
-                }
-                else
-                {
-                    xL = boneVertices[iB * 2];
-                    yL = boneVertices[iB * 2 + 1];
-                }
+        const auto& vertices = this->_skinnedVertices;
+        const auto& bounds = this->_skinnedBounds;
 
-                xG += (matrix->a * xL + matrix->c * yL + matrix->tx) * weight;
-                yG += (matrix->b * xL + matrix->d * yL + matrix->ty) * weight;
-
-                iF += 2;
-            }
-
-            auto& vertices = displayVertices[iH];
-            auto& vertex = vertices.vertices;
-
-            vertex.set(xG, -yG, 0.f);
-
-            if (boundsRect.origin.x > xG)
-            {
-                boundsRect.origin.x = xG;
-            }
-
-            if (boundsRect.size.width < xG)
-            {
-                boundsRect.size.width = xG;
-            }
+        for (std::size_t i = 0, l = vertices.size(); i < l; i += 2)
+        {
+            displayVertices[i / 2].vertices.set(vertices[i], -vertices[i + 1], 0.f);
+        }
 
-            if (boundsRect.origin.y > -yG)
+        boundsRect.setRect(bounds.x, -(bounds.y + bounds.height), bounds.width, bounds.height);
+    }
+    else if (hasFFD)
+    {
+        // Only vertices that are or were deformed move, the others stay at their rest position.
+        auto begin = this->_ffdBegin;
+        auto end = this->_ffdEnd;
+        if (_deformedBegin < _deformedEnd)
+        {
+            if (begin < end)
             {
-                boundsRect.origin.y = -yG;
+                begin = std::min(begin, _deformedBegin);
+                end = std::max(end, _deformedEnd);
             }
-
-            if (boundsRect.size.height < -yG)
+            else
             {
-                boundsRect.size.height = -yG;
+                begin = _deformedBegin;
+                end = _deformedEnd;
             }
         }
-    }
-    else if (hasFFD)
-    {
+
         const auto& vertices = _meshData->vertices;
         for (std::size_t i = 0, l = this->_meshData->vertices.size(); i < l; i += 2)
         {
             const auto iH = unsigned(i / 2);
-            const auto xG = vertices[i] + _ffdVertices[i];
-            const auto yG = vertices[i + 1] + _ffdVertices[i + 1];
+            auto& vertex = displayVertices[iH].vertices;
 
-            auto& vertices = displayVertices[iH];
-            auto& vertex = vertices.vertices;
+            if (i + 1 >= begin && i < end)
+            {
+                vertex.set(vertices[i] + _ffdVertices[i], -(vertices[i + 1] + _ffdVertices[i + 1]), 0.f);
+            }
 
-            vertex.set(xG, -yG, 0.f);
+            const auto xG = vertex.x;
+            const auto yG = -vertex.y;
 
             if (boundsRect.origin.x > xG)
             {
@@ -410,12 +376,15 @@ void CCSlot::_updateMesh()
                 boundsRect.size.height = -yG;
             }
         }
-    }
 
-    boundsRect.size.width -= boundsRect.origin.x;
-    boundsRect.size.height -= boundsRect.origin.y;
+        _deformedBegin = this->_ffdBegin;
+        _deformedEnd = this->_ffdEnd;
+
+        boundsRect.size.width -= boundsRect.origin.x;
+        boundsRect.size.height -= boundsRect.origin.y;
+    }
     
-    meshDisplay->getPolygonInfo().rect = boundsRect; // copy
+    meshDisplay->setMeshRect(boundsRect);
     meshDisplay->setContentSize(boundsRect.size);
 }
 
@@ -440,4 +409,13 @@ void CCSlot::_updateTransform()
     }
 }
 
+CCBatchSlot::CCBatchSlot()
+{
+    _onClear();
+}
+CCBatchSlot::~CCBatchSlot()
+{
+    _onClear();
+}
+
 DRAGONBONES_NAMESPACE_END
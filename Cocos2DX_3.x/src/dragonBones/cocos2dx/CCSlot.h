@@ -10,7 +10,12 @@ class CCSlot : public Slot
     BIND_CLASS_TYPE(CCSlot);
 
 private:
+    /** Range of mesh vertices currently moved by FFD, in _ffdVertices indices. */
+    std::size_t _deformedBegin;
+    std::size_t _deformedEnd;
     cocos2d::Node* _renderDisplay;
+    /** Vertices of the current mesh display, drawn in place by the sprite. Kept with the pooled slot so display switches reuse its capacity. */
+    std::vector<cocos2d::V3F_C4B_T2F> _meshVertices;
 
 public:
     CCSlot();
@@ -39,5 +44,38 @@ public:
     virtual void _updateBlendMode() override;
 };
 
+/**
+ * Slot without a cocos2d-x node, drawn by its CCArmatureBatchDisplay from slot transforms and mesh data.
+ */
+class CCBatchSlot : public Slot
+{
+    BIND_CLASS_TYPE(CCBatchSlot);
+
+public:
+    CCBatchSlot();
+    ~CCBatchSlot();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(CCBatchSlot);
+
+protected:
+    virtual void _initDisplay(void* value) override {}
+    virtual void _onUpdateDisplay() override {}
+    virtual void _addDisplay() override {}
+    virtual void _replaceDisplay(void* value, bool isArmatureDisplayContainer) override {}
+    virtual void _removeDisplay() override {}
+    virtual void _disposeDisplay(void* value) override {}
+    virtual void _updateColor() override {}
+    virtual void _updateFilters() override {}
+    virtual void _updateFrame() override {}
+    virtual void _updateMesh() override {}
+    virtual void _updateTransform() override {}
+
+public:
+    virtual void _updateVisible() override {}
+    virtual void _updateBlendMode() override {}
+    virtual bool _isThreadSafe() const override { return true; }
+};
+
 DRAGONBONES_NAMESPACE_END
 #endif // DRAGONBONES_CC_SLOT_H
@@ -4,6 +4,7 @@
 // core
 #include "core/DragonBones.h"
 #include "core/BaseObject.h"
+#include "core/WorkerPool.h"
 
 // geom
 #include "geom/ColorTransform.h"
@@ -35,6 +36,11 @@
 #include "armature/TransformObject.h"
 #include "armature/Bone.h"
 #include "armature/Slot.h"
+#include "armature/MeshDeformer.h"
+#include "armature/DrawableSlotVisitor.h"
+#include "armature/RenderBatchBuilder.h"
+#include "armature/Crowd.h"
+#include "armature/PoseSnapshot.h"
 
 // animation
 #include "animation/IAnimateble.h"
@@ -43,6 +49,7 @@
 #include "animation/AnimationState.h"
 #include "animation/BaseTimelineState.h"
 #include "animation/TimelineState.h"
+#include "animation/PoseSampler.h"
 
 // events
 #include "events/EventObject.h"
@@ -204,6 +204,24 @@ void Animation::_advanceTime(float passedTime)
     _timelineStateDirty = false;
 }
 
+bool Animation::_canSleep() const
+{
+    if (!_isPlaying)
+    {
+        return true;
+    }
+
+    for (const auto animationState : _animationStates)
+    {
+        if (!animationState->_canSleep())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void Animation::reset()
 {
     _isPlaying = false;
@@ -247,6 +265,7 @@ AnimationState* Animation::play(const std::string& animationName, int playTimes)
     else if (!_isPlaying)
     {
         _isPlaying = true;
+        _armature->wakeUp();
     }
     else
     {
@@ -271,6 +290,7 @@ AnimationState* Animation::fadeIn(
     }
 
     _isPlaying = true;
+    _armature->wakeUp();
 
     if (fadeInTime != fadeInTime || fadeInTime < 0.f)
     {
@@ -51,6 +51,7 @@ protected:
 public:
     void _updateFFDTimelineStates();
     void _advanceTime(float passedTime);
+    bool _canSleep() const;
 
 public:
     void reset();
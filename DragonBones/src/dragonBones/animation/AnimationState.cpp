@@ -48,6 +48,7 @@ void AnimationState::_onClear()
     _currentPlayTimes = 0;
     _fadeTime = 0.f;
     _time = 0.f;
+    _constantWeightResult = -1.f;
     _name.clear();
     _armature = nullptr;
     _clip = nullptr;
@@ -100,26 +101,24 @@ void AnimationState::_advanceFadeTime(float passedTime)
     {
         _fadeProgress = fadeProgress;
 
-        const auto eventDispatcher = _armature->_display;
-
         if (_fadeTime <= passedTime)
         {
             if (_isFadeOut)
             {
-                if (eventDispatcher->hasEvent(EventObject::FADE_OUT))
+                if (_armature->_hasEvent(EventObjectType::FadeOut))
                 {
                     auto event = BaseObject::borrowObject<EventObject>();
                     event->animationState = this;
-                    _armature->_bufferEvent(event, EventObject::FADE_OUT);
+                    _armature->_bufferEvent(event, EventObjectType::FadeOut);
                 }
             }
             else
             {
-                if (eventDispatcher->hasEvent(EventObject::FADE_IN))
+                if (_armature->_hasEvent(EventObjectType::FadeIn))
                 {
                     auto event = BaseObject::borrowObject<EventObject>();
                     event->animationState = this;
-                    _armature->_bufferEvent(event, EventObject::FADE_IN);
+                    _armature->_bufferEvent(event, EventObjectType::FadeIn);
                 }
             }
         }
@@ -130,22 +129,22 @@ void AnimationState::_advanceFadeTime(float passedTime)
             {
                 _isFadeOutComplete = true;
 
-                if (eventDispatcher->hasEvent(EventObject::FADE_OUT_COMPLETE))
+                if (_armature->_hasEvent(EventObjectType::FadeOutComplete))
                 {
                     auto event = BaseObject::borrowObject<EventObject>();
                     event->animationState = this;
-                    _armature->_bufferEvent(event, EventObject::FADE_OUT_COMPLETE);
+                    _armature->_bufferEvent(event, EventObjectType::FadeOutComplete);
                 }
             }
             else
             {
                 _isPausePlayhead = false;
 
-                if (eventDispatcher->hasEvent(EventObject::FADE_IN_COMPLETE))
+                if (_armature->_hasEvent(EventObjectType::FadeInComplete))
                 {
                     auto event = BaseObject::borrowObject<EventObject>();
                     event->animationState = this;
-                    _armature->_bufferEvent(event, EventObject::FADE_IN_COMPLETE);
+                    _armature->_bufferEvent(event, EventObjectType::FadeInComplete);
                 }
             }
         }
@@ -282,6 +281,8 @@ void AnimationState::_updateTimelineStates()
         timelineState->returnToPool();
     }
 
+    _constantWeightResult = -1.f;
+
     _updateFFDTimelineStates();
 }
 
@@ -328,6 +329,9 @@ void AnimationState::_updateFFDTimelineStates()
                 const auto totalCount = slot->_ffdVertices.size();
                 slot->_ffdVertices.clear();
                 slot->_ffdVertices.resize(totalCount, 0.f);
+                slot->_ffdBegin = 0;
+                slot->_ffdEnd = 0;
+                slot->_ffdRuns.clear();
                 slot->_ffdDirty = true;
             }
         }
@@ -363,6 +367,21 @@ void AnimationState::_advanceTime(float passedTime, float weightLeft, int index)
 
     _weightResult = weight * _fadeProgress * weightLeft;
 
+    // Culled armatures skip the pose, only timelines that carry events still have to run.
+    if (_weightResult != 0.f && _armature->_isCulled() && !_clip->hasBoneTimelineEvent && !_clip->hasSlotTimelineEvent)
+    {
+        _constantWeightResult = -1.f;
+
+        // Keeps cached bounds following the animation.
+        if (_fadeProgress >= 1.f && index == 0 && _armature->getCacheFrameRate() > 0)
+        {
+            _armature->_cacheFrameIndex = (unsigned)(_timeline->_currentTime * _clip->cacheTimeToFrameScale);
+            _armature->_cacheAnimationData = _clip;
+        }
+
+        return;
+    }
+
     if (_weightResult != 0.f)
     {
         auto time = _time;
@@ -371,10 +390,36 @@ void AnimationState::_advanceTime(float passedTime, float weightLeft, int index)
             time = _timeline->_currentTime;
         }
 
+        // Constant timelines keep their last result while this is the only state and its weight is unchanged.
+        const auto isConstantApplied = _fadeProgress >= 1.f && index == 0 && _weightResult == _constantWeightResult;
+        _constantWeightResult = (_fadeProgress >= 1.f && index == 0) ? _weightResult : -1.f;
+
         if (_fadeProgress >= 1.f && index == 0 && _armature->getCacheFrameRate() > 0)
         {
             std::size_t cacheFrameIndex = (unsigned)(_timeline->_currentTime * _clip->cacheTimeToFrameScale);
             _armature->_cacheFrameIndex = cacheFrameIndex;
+            _armature->_cacheAnimationData = _clip;
+
+            // Another armature already evaluated this frame in this tick, only the slot states of this armature are kept.
+            if (_weightResult == 1.f && _armature->_followPose(*_clip, cacheFrameIndex))
+            {
+                _constantWeightResult = -1.f;
+
+                for (const auto timelineState : _slotTimelines)
+                {
+                    if (!timelineState->_applyCachedState(cacheFrameIndex))
+                    {
+                        timelineState->update(time);
+                    }
+                }
+
+                for (const auto timelineState : _ffdTimelines)
+                {
+                    timelineState->update(time);
+                }
+
+                return;
+            }
 
             if (_armature->_animation->_animationStateDirty)
             {
@@ -391,13 +436,31 @@ void AnimationState::_advanceTime(float passedTime, float weightLeft, int index)
                 }
             }
 
-            if (!_clip->cachedFrames[cacheFrameIndex] || _clip->hasBoneTimelineEvent)
-            {
-                _clip->cachedFrames[cacheFrameIndex] = true;
+            const bool isCached = _clip->cachedFrames[cacheFrameIndex];
+            _clip->cachedFrames[cacheFrameIndex] = true;
 
+            if (!isCached || _clip->hasBoneTimelineEvent)
+            {
                 for (const auto timelineState : _boneTimelines)
+                {
+                    if (!isConstantApplied || !timelineState->_timeline->isConstant())
+                    {
+                        timelineState->update(time);
+                    }
+                }
+            }
+
+            for (const auto timelineState : _slotTimelines)
+            {
+                if (isConstantApplied && timelineState->_timeline->isConstant())
+                {
+                    continue;
+                }
+
+                if (!isCached || _clip->hasSlotTimelineEvent || !timelineState->_applyCachedState(cacheFrameIndex))
                 {
                     timelineState->update(time);
+                    timelineState->_cacheState(cacheFrameIndex);
                 }
             }
         }
@@ -407,13 +470,19 @@ void AnimationState::_advanceTime(float passedTime, float weightLeft, int index)
 
             for (const auto timelineState : _boneTimelines)
             {
-                timelineState->update(time);
+                if (!isConstantApplied || !timelineState->_timeline->isConstant())
+                {
+                    timelineState->update(time);
+                }
             }
-        }
 
-        for (const auto timelineState : _slotTimelines)
-        {
-            timelineState->update(time);
+            for (const auto timelineState : _slotTimelines)
+            {
+                if (!isConstantApplied || !timelineState->_timeline->isConstant())
+                {
+                    timelineState->update(time);
+                }
+            }
         }
 
         for (const auto timelineState : _ffdTimelines)
@@ -423,9 +492,15 @@ void AnimationState::_advanceTime(float passedTime, float weightLeft, int index)
     }
 }
 
+bool AnimationState::_canSleep() const
+{
+    return !_isFadeOut && _fadeProgress >= 1.f && (!_isPlaying || _isPausePlayhead || _timeline->_isCompleted);
+}
+
 void AnimationState::play()
 {
     _isPlaying = true;
+    _armature->wakeUp();
 }
 
 void AnimationState::stop()
@@ -440,6 +515,8 @@ void AnimationState::fadeOut(float fadeOutTime, bool pausePlayhead)
         fadeOutTime = 0.f;
     }
 
+    _armature->wakeUp();
+
     _isPausePlayhead = pausePlayhead;
 
     if (_isFadeOut)
@@ -506,6 +583,7 @@ void AnimationState::addBoneMask(const std::string& name, bool recursive)
     }
 
     _updateTimelineStates();
+    _armature->wakeUp();
 }
 
 void AnimationState::removeBoneMask(const std::string& name, bool recursive)
@@ -537,12 +615,14 @@ void AnimationState::removeBoneMask(const std::string& name, bool recursive)
     }
 
     _updateTimelineStates();
+    _armature->wakeUp();
 }
 
 void AnimationState::removeAllBoneMask()
 {
     _boneMask.clear();
     _updateTimelineStates();
+    _armature->wakeUp();
 }
 
 bool AnimationState::getIsCompleted() const
@@ -562,7 +642,10 @@ void AnimationState::setCurrentTime(float value)
         value = 0;
     }
 
+    _armature->wakeUp();
+
     _time = value;
+    _constantWeightResult = -1.f;
     _timeline->setCurrentTime(_time);
 
     if (_weightResult != 0.f)
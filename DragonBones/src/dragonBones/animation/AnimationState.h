@@ -45,6 +45,7 @@ private:
     unsigned _currentPlayTimes;
     float _fadeTime;
     float _time;
+    float _constantWeightResult;
     std::string _name;
     Armature* _armature;
     AnimationData* _clip;
@@ -74,6 +75,8 @@ public:
     void _updateTimelineStates();
     void _updateFFDTimelineStates();
     void _advanceTime(float passedTime, float weightLeft, int index);
+    /** Faded in and its playhead can not move, so its result stays the same. */
+    bool _canSleep() const;
 
 public:
     void play();
@@ -78,7 +78,7 @@ protected:
                     const auto childArmature = slot->getChildArmature();
                     if (childArmature)
                     {
-                        childArmature->_action = actionData;
+                        childArmature->_bufferAction(actionData);
                     }
                 }
             }
@@ -89,33 +89,20 @@ protected:
                     const auto childArmature = slot->getChildArmature();
                     if (childArmature)
                     {
-                        childArmature->_action = actionData;
+                        childArmature->_bufferAction(actionData);
                     }
                 }
             }
             else
             {
-                _armature->_action = actionData;
+                _armature->_bufferAction(actionData);
             }
         }
         
-        const auto eventDispatcher = _armature->_display;
-
         for (const auto eventData : frame->events)
         {
-            std::string eventType;
-            switch (eventData->type)
-            {
-                case EventType::Frame:
-                    eventType = EventObject::FRAME_EVENT;
-                    break;
-
-                case EventType::Sound:
-                    eventType = EventObject::SOUND_EVENT;
-                    break;
-            }
-
-            if (eventDispatcher->hasEvent(eventType))
+            const auto eventType = eventData->type == EventType::Sound ? EventObjectType::Sound : EventObjectType::Frame;
+            if (_armature->_hasEvent(eventType))
             {
                 const auto eventObject = BaseObject::borrowObject<EventObject>();
                 eventObject->animationState = _animationState;
@@ -130,7 +117,7 @@ protected:
                     eventObject->slot = _armature->getSlot(eventData->slot->name);
                 }
 
-                eventObject->name = eventData->name;
+                eventObject->_name = &eventData->name;
                 //eventObject->data = eventData->data; // TODO
 
                 _armature->_bufferEvent(eventObject, eventType);
@@ -230,7 +217,7 @@ public:
                 break;
 
             default:
-                _currentFrame = _timeline->frames[(unsigned)(_currentTime * _timeToFrameSccale)];
+                _currentFrame = _timeline->getFrame((unsigned)(_currentTime * _timeToFrameSccale));
                 _onArriveAtFrame(false);
                 _onUpdateFrame(false);
                 break;
@@ -274,7 +261,7 @@ public:
         if (!_isCompleted && _setCurrentTime(time) && _keyFrameCount)
         {
             const unsigned currentFrameIndex = _keyFrameCount > 1 ? unsigned(_currentTime * _timeToFrameSccale) : 0;
-            const auto currentFrame = _timeline->frames[currentFrameIndex];
+            const auto currentFrame = _timeline->getFrame(currentFrameIndex);
             if (_currentFrame != currentFrame)
             {
                 if (_keyFrameCount > 1)
@@ -318,7 +305,7 @@ public:
 template<class T, class M>
 class TweenTimelineState : public TimelineState<T, M>
 {
-protected:
+public: // private
     static float _getEasingValue(float progress, float easing)
     {
         auto value = 1.f;
@@ -333,12 +320,12 @@ protected:
         }
         else if (easing > 0.f) // Ease out
         {
-            value = 1.f - std::pow(1.f - progress, 2);
+            value = 1.f - (1.f - progress) * (1.f - progress);
         }
         else if (easing >= -1.f) // Ease in
         {
             easing *= -1.f;
-            value = std::pow(progress, 2);
+            value = progress * progress;
         }
         else if (easing >= -2.f) // Ease out in
         {
@@ -356,29 +343,12 @@ protected:
 
     static float _getCurveEasingValue(float progress, const std::vector<float>& sampling)
     {
-        auto x = 0.f;
-        auto y = 0.f;
+        const auto segmentCount = sampling.size() - 1;
+        const auto position = progress * segmentCount;
+        const std::size_t index = position > 0.f ? std::min((std::size_t)position, segmentCount - 1) : 0;
+        const auto value = sampling[index];
 
-        for (std::size_t i = 0, l = sampling.size(); i < l; i += 2)
-        {
-            x = sampling[i];
-            y = sampling[i + 1];
-            if (x >= progress)
-            {
-                if (i == 0)
-                {
-                    return y * progress / x;
-                }
-                else
-                {
-                    const auto xP = sampling[i - 2];
-                    const auto yP = sampling[i - 1]; // i - 2 + 1
-                    return yP + (y - yP) * (progress - xP) / (x - xP);
-                }
-            }
-        }
-
-        return y + (1.f - y) * (progress - x) / (1.f - x);
+        return value + (sampling[index + 1] - value) * (position - index);
     }
 
 protected:
@@ -451,16 +421,35 @@ protected:
     TweenType _updateExtensionKeyFrame(const ExtensionFrameData& current, const ExtensionFrameData& next, ExtensionFrameData& result)
     {
         auto tweenType = TweenType::None;
+
         if (current.type == next.type)
         {
-            for (std::size_t i = 0, l = current.tweens.size(); i < l; ++i)
-            {
-                const auto tweenDuration = next.tweens[i] - current.tweens[i];
-                result.tweens[i] = tweenDuration;
+            ExtensionFrameData::unionRuns(current.runs, next.runs, result.runs);
+        }
+        else
+        {
+            result.runs = current.runs; // copy
+        }
+
+        std::size_t count = 0;
+        for (std::size_t i = 0, l = result.runs.size(); i < l; i += 2)
+        {
+            count += result.runs[i + 1] - result.runs[i];
+        }
+
+        result.tweens.assign(count, 0.f);
 
+        if (current.type == next.type)
+        {
+            next.addTweens(result.runs, 1.f, result.tweens.data());
+            current.addTweens(result.runs, -1.f, result.tweens.data());
+
+            for (const auto tweenDuration : result.tweens)
+            {
                 if (tweenDuration != 0.f)
                 {
                     tweenType = TweenType::Always;
+                    break;
                 }
             }
         }
@@ -473,12 +462,6 @@ protected:
                 result.type = current.type;
             }
 
-            if (result.tweens.size() != current.tweens.size())
-            {
-                tweenType = TweenType::Once;
-                result.tweens.resize(current.tweens.size(), 0.f);
-            }
-
             if (result.keys.size() != current.keys.size())
             {
                 tweenType = TweenType::Once;
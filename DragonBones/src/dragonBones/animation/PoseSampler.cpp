@@ -0,0 +1,777 @@
+#include "PoseSampler.h"
+#include "TimelineState.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+PoseSampler::PoseSampler(ArmatureData& armatureData) :
+    _armatureData(&armatureData),
+    _bones(armatureData.getSortedBones()),
+    _parentIndices(),
+    _ikIndices(),
+    _ikChains(),
+    _animations(),
+    _boneTimelines()
+{
+    const auto getIndex = [this](const BoneData* boneData)
+    {
+        const auto iterator = std::find(_bones.cbegin(), _bones.cend(), boneData);
+        return iterator != _bones.cend() ? (int)(iterator - _bones.cbegin()) : -1;
+    };
+
+    const auto contains = [](const BoneData* ancestor, const BoneData* child)
+    {
+        while (child && child != ancestor)
+        {
+            child = child->parent;
+        }
+
+        return child != nullptr;
+    };
+
+    for (const auto boneData : _bones)
+    {
+        auto ikIndex = -1;
+        auto isChain = false;
+
+        // Same chains and loop checks as Bone::_setIK().
+        if (boneData->ik && boneData->weight > 0.f && boneData->chain == boneData->chainIndex)
+        {
+            isChain = boneData->chain > 0 && boneData->parent;
+            const auto chainEnd = isChain ? boneData->parent : boneData;
+            auto isValid = !isChain || boneData->chain == 1;
+
+            if (isValid && (chainEnd == boneData->ik || contains(chainEnd, boneData->ik)))
+            {
+                isValid = false;
+            }
+
+            auto ancestor = boneData->ik;
+            while (isValid && ancestor->ik && ancestor->chain > 0 && ancestor->parent)
+            {
+                if (contains(chainEnd, ancestor->ik))
+                {
+                    isValid = false;
+                }
+
+                ancestor = ancestor->parent;
+            }
+
+            if (isValid)
+            {
+                ikIndex = getIndex(boneData->ik);
+            }
+        }
+
+        _parentIndices.push_back(getIndex(boneData->parent));
+        _ikIndices.push_back(ikIndex);
+        _ikChains.push_back(ikIndex >= 0 && isChain && boneData->inheritTranslation);
+    }
+
+    for (const auto& pair : armatureData.animations)
+    {
+        const auto animationData = pair.second;
+        _animations.push_back(animationData);
+        _boneTimelines.resize(_boneTimelines.size() + 1);
+
+        auto& boneTimelines = _boneTimelines.back();
+        for (const auto boneData : _bones)
+        {
+            const auto timelineData = (animationData->animation ? animationData->animation : animationData)->getBoneTimeline(boneData->name);
+            boneTimelines.push_back(timelineData && !timelineData->frames.empty() ? timelineData : nullptr);
+        }
+    }
+}
+PoseSampler::~PoseSampler()
+{
+}
+
+float PoseSampler::_getPlayTime(float time, unsigned playTimes, float duration, unsigned& currentPlayTimes)
+{
+    const auto totalTimes = playTimes * duration;
+
+    if (playTimes > 0 && (time >= totalTimes || time <= -totalTimes))
+    {
+        currentPlayTimes = playTimes;
+        return time < 0.f ? 0.f : duration;
+    }
+
+    if (duration <= 0.f)
+    {
+        currentPlayTimes = 0;
+        return 0.f;
+    }
+
+    if (time < 0.f)
+    {
+        currentPlayTimes = (unsigned)(-time / duration);
+        time = duration - std::fmod(-time, duration);
+    }
+    else
+    {
+        currentPlayTimes = (unsigned)(time / duration);
+        time = std::fmod(time, duration);
+    }
+
+    if (playTimes > 0 && currentPlayTimes > playTimes)
+    {
+        currentPlayTimes = playTimes;
+    }
+
+    return time;
+}
+
+inline void PoseSampler::_sinCos(float value, float& sin, float& cos)
+{
+    // Cephes sinf() and cosf() on the nearest multiple of PI / 2, the quadrant picks and signs the results.
+    const auto quadrant = (int)(value * (2.f / PI) + (value >= 0.f ? 0.5f : -0.5f));
+    const auto multiple = (float)quadrant;
+    const auto x = ((value - multiple * 1.5703125f) - multiple * 4.837512969970703125e-4f) - multiple * 7.54978995489188216e-8f;
+    const auto z = x * x;
+    const auto sinX = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x + x;
+    const auto cosX = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.f;
+    const auto isSwapped = (quadrant & 1) != 0;
+
+    sin = (isSwapped ? cosX : sinX) * ((quadrant & 2) ? -1.f : 1.f);
+    cos = (isSwapped ? sinX : cosX) * (((quadrant + 1) & 2) ? -1.f : 1.f);
+}
+
+inline float PoseSampler::_atan(float y, float x)
+{
+    // Cephes atanf() on the smaller of y / x and x / y, reduced by PI / 4 past tan(PI / 8). Both divisions run for every lane,
+    // each select follows its condition right away so compilers do not copy the polynomial into a branch per case.
+    const auto absY = std::fabs(y);
+    const auto absX = std::fabs(x);
+    const auto ratio = absY / absX;
+    const auto inverseRatio = absX / absY;
+    const auto isInverse = inverseRatio < ratio;
+    const auto r = isInverse ? inverseRatio : ratio;
+    const auto inverseOffset = isInverse ? PI * 0.5f : 0.f;
+    const auto inverseSign = isInverse ? -1.f : 1.f;
+    const auto reduced = (r - 1.f) / (r + 1.f);
+    const auto isReduced = std::fabs(reduced) < r;
+    const auto t = isReduced ? reduced : r;
+    const auto reducedOffset = isReduced ? PI_Q : 0.f;
+    const auto sign = (y < 0.f) != (x < 0.f) ? -1.f : 1.f;
+    const auto z = t * t;
+    const auto result = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t;
+
+    return sign * (inverseOffset + inverseSign * (reducedOffset + result));
+}
+
+void PoseSampler::_getLane(const PoseSamplerScratch::BoneLanes& lanes, std::size_t lane, Transform& global, Matrix& matrix)
+{
+    global.x = lanes.x[lane];
+    global.y = lanes.y[lane];
+    global.skewX = lanes.skewX[lane];
+    global.skewY = lanes.skewY[lane];
+    global.scaleX = lanes.scaleX[lane];
+    global.scaleY = lanes.scaleY[lane];
+    matrix.a = lanes.a[lane];
+    matrix.b = lanes.b[lane];
+    matrix.c = lanes.c[lane];
+    matrix.d = lanes.d[lane];
+    matrix.tx = lanes.tx[lane];
+    matrix.ty = lanes.ty[lane];
+}
+
+void PoseSampler::_setLane(PoseSamplerScratch::BoneLanes& lanes, std::size_t lane, const Transform& global, const Matrix& matrix)
+{
+    lanes.x[lane] = global.x;
+    lanes.y[lane] = global.y;
+    lanes.skewX[lane] = global.skewX;
+    lanes.skewY[lane] = global.skewY;
+    lanes.scaleX[lane] = global.scaleX;
+    lanes.scaleY[lane] = global.scaleY;
+    lanes.a[lane] = matrix.a;
+    lanes.b[lane] = matrix.b;
+    lanes.c[lane] = matrix.c;
+    lanes.d[lane] = matrix.d;
+    lanes.tx[lane] = matrix.tx;
+    lanes.ty[lane] = matrix.ty;
+}
+
+void PoseSampler::_sampleBone(const AnimationData& animation, const BoneTimelineData& timeline, float time, unsigned frameIndex, unsigned playTimes, Transform& pose) const
+{
+    const auto keyFrameCount = timeline.frames.size();
+    const auto& frame = *timeline.getFrame(keyFrameCount > 1 ? frameIndex : 0);
+    const auto& origin = timeline.originTransform;
+    const auto& current = frame.transform;
+
+    auto tweenEasing = frame.tweenEasing;
+    auto curve = frame.curve.empty() ? nullptr : &frame.curve;
+
+    // The last play, or a completed one, does not tween back to the first frame.
+    if (
+        keyFrameCount == 1 ||
+        (
+            frame.next == timeline.frames[0] &&
+            (tweenEasing != NO_TWEEN || curve) &&
+            animation.playTimes > 0 &&
+            playTimes + 1 >= animation.playTimes
+        )
+    )
+    {
+        tweenEasing = NO_TWEEN;
+        curve = nullptr;
+    }
+
+    Transform duration;
+    duration.scaleX = duration.scaleY = 0.f;
+    auto tweenProgress = 0.f;
+
+    if (tweenEasing != NO_TWEEN || curve)
+    {
+        const auto& next = frame.next->transform;
+
+        duration.x = next.x - current.x;
+        duration.y = next.y - current.y;
+
+        const auto tweenRotate = frame.tweenRotate;
+        if (tweenRotate)
+        {
+            const auto rotate =
+                (tweenRotate > 0 ? next.skewY >= current.skewY : next.skewY <= current.skewY) ?
+                (tweenRotate > 0 ? tweenRotate - 1 : tweenRotate + 1) : tweenRotate;
+
+            duration.skewX = next.skewX - current.skewX + PI_D * rotate;
+            duration.skewY = next.skewY - current.skewY + PI_D * rotate;
+        }
+        else
+        {
+            duration.skewX = Transform::normalizeRadian(next.skewX - current.skewX);
+            duration.skewY = Transform::normalizeRadian(next.skewY - current.skewY);
+        }
+
+        if (frame.tweenScale)
+        {
+            duration.scaleX = next.scaleX - current.scaleX;
+            duration.scaleY = next.scaleY - current.scaleY;
+        }
+
+        typedef TweenTimelineState<BoneFrameData, BoneTimelineData> TweenState;
+
+        if (tweenEasing != NO_TWEEN && frame.duration > 0)
+        {
+            tweenProgress = (time - frame.position + animation.position) / frame.duration;
+            if (tweenEasing != 0.f)
+            {
+                tweenProgress = TweenState::_getEasingValue(tweenProgress, tweenEasing);
+            }
+        }
+        else if (curve)
+        {
+            tweenProgress = (time - frame.position + animation.position) / frame.duration;
+            tweenProgress = TweenState::_getCurveEasingValue(tweenProgress, *curve);
+        }
+    }
+
+    pose.x = origin.x + current.x + duration.x * tweenProgress;
+    pose.y = origin.y + current.y + duration.y * tweenProgress;
+    pose.skewX = origin.skewX + current.skewX + duration.skewX * tweenProgress;
+    pose.skewY = origin.skewY + current.skewY + duration.skewY * tweenProgress;
+    pose.scaleX = origin.scaleX * (current.scaleX + duration.scaleX * tweenProgress);
+    pose.scaleY = origin.scaleY * (current.scaleY + duration.scaleY * tweenProgress);
+}
+
+void PoseSampler::_updateGlobal(const BoneData& boneData, Transform& global, Matrix& globalTransformMatrix, const Transform* parentGlobal, const Matrix* parentMatrix)
+{
+    if (!parentGlobal)
+    {
+        global.toMatrix(globalTransformMatrix);
+    }
+    else if (boneData.inheritScale)
+    {
+        if (!boneData.inheritRotation)
+        {
+            global.skewX -= parentGlobal->skewY;
+            global.skewY -= parentGlobal->skewY;
+        }
+
+        global.toMatrix(globalTransformMatrix);
+        globalTransformMatrix.concat(*parentMatrix);
+
+        if (!boneData.inheritTranslation)
+        {
+            globalTransformMatrix.tx = global.x;
+            globalTransformMatrix.ty = global.y;
+        }
+
+        global.fromMatrix(globalTransformMatrix);
+    }
+    else
+    {
+        if (boneData.inheritTranslation)
+        {
+            const auto x = global.x;
+            const auto y = global.y;
+            global.x = parentMatrix->a * x + parentMatrix->c * y + parentMatrix->tx;
+            global.y = parentMatrix->d * y + parentMatrix->b * x + parentMatrix->ty;
+        }
+
+        if (boneData.inheritRotation)
+        {
+            global.skewX += parentGlobal->skewY;
+            global.skewY += parentGlobal->skewY;
+        }
+
+        global.toMatrix(globalTransformMatrix);
+    }
+}
+
+void PoseSampler::_updateGlobalLanes(const BoneData& boneData, PoseSamplerScratch::BoneLanes& lanes, const PoseSamplerScratch::BoneLanes* parentLanes) const
+{
+    const auto LANE_COUNT = PoseSamplerScratch::LANE_COUNT;
+
+    // Fixed length loops over the lanes of one block, every condition is a select so they vectorize.
+    if (!parentLanes)
+    {
+        for (unsigned i = 0; i < LANE_COUNT; ++i)
+        {
+            float sinX, cosX, sinY, cosY;
+            _sinCos(lanes.skewX[i], sinX, cosX);
+            _sinCos(lanes.skewY[i], sinY, cosY);
+            lanes.a[i] = lanes.scaleX[i] * cosY;
+            lanes.b[i] = lanes.scaleX[i] * sinY;
+            lanes.c[i] = -lanes.scaleY[i] * sinX;
+            lanes.d[i] = lanes.scaleY[i] * cosX;
+            lanes.tx[i] = lanes.x[i];
+            lanes.ty[i] = lanes.y[i];
+        }
+
+        return;
+    }
+
+    // Copied, the compiler can not tell that the parent block is not this one.
+    float parentA[LANE_COUNT], parentB[LANE_COUNT], parentC[LANE_COUNT], parentD[LANE_COUNT];
+    float parentTX[LANE_COUNT], parentTY[LANE_COUNT], parentSkewY[LANE_COUNT];
+    for (unsigned i = 0; i < LANE_COUNT; ++i)
+    {
+        parentA[i] = parentLanes->a[i];
+        parentB[i] = parentLanes->b[i];
+        parentC[i] = parentLanes->c[i];
+        parentD[i] = parentLanes->d[i];
+        parentTX[i] = parentLanes->tx[i];
+        parentTY[i] = parentLanes->ty[i];
+        parentSkewY[i] = parentLanes->skewY[i];
+    }
+
+    // The inherit flags scale by one or zero rather than select, compilers do not vectorize a select on a bool of the data.
+    const auto parentRotation = boneData.inheritRotation ? 1.f : 0.f;
+    const auto parentTranslation = boneData.inheritTranslation ? 1.f : 0.f;
+    const auto localTranslation = 1.f - parentTranslation;
+
+    if (!boneData.inheritScale)
+    {
+        for (unsigned i = 0; i < LANE_COUNT; ++i)
+        {
+            const auto x = lanes.x[i];
+            const auto y = lanes.y[i];
+            const auto parentX = parentA[i] * x + parentC[i] * y + parentTX[i];
+            const auto parentY = parentD[i] * y + parentB[i] * x + parentTY[i];
+            const auto globalX = parentX * parentTranslation + x * localTranslation;
+            const auto globalY = parentY * parentTranslation + y * localTranslation;
+            const auto skewX = lanes.skewX[i] + parentSkewY[i] * parentRotation;
+            const auto skewY = lanes.skewY[i] + parentSkewY[i] * parentRotation;
+
+            float sinX, cosX, sinY, cosY;
+            _sinCos(skewX, sinX, cosX);
+            _sinCos(skewY, sinY, cosY);
+            lanes.x[i] = globalX;
+            lanes.y[i] = globalY;
+            lanes.skewX[i] = skewX;
+            lanes.skewY[i] = skewY;
+            lanes.a[i] = lanes.scaleX[i] * cosY;
+            lanes.b[i] = lanes.scaleX[i] * sinY;
+            lanes.c[i] = -lanes.scaleY[i] * sinX;
+            lanes.d[i] = lanes.scaleY[i] * cosX;
+            lanes.tx[i] = globalX;
+            lanes.ty[i] = globalY;
+        }
+
+        return;
+    }
+
+    // Transform::toMatrix(), Matrix::concat() and the arctangents of Transform::fromMatrix(). The local scale stays for the flip test.
+    for (unsigned i = 0; i < LANE_COUNT; ++i)
+    {
+        const auto parentSkew = parentSkewY[i] * (1.f - parentRotation);
+        const auto scaleX = lanes.scaleX[i];
+        const auto scaleY = lanes.scaleY[i];
+
+        float sinX, cosX, sinY, cosY;
+        _sinCos(lanes.skewX[i] - parentSkew, sinX, cosX);
+        _sinCos(lanes.skewY[i] - parentSkew, sinY, cosY);
+        const auto aA = scaleX * cosY;
+        const auto bA = scaleX * sinY;
+        const auto cA = -scaleY * sinX;
+        const auto dA = scaleY * cosX;
+        const auto txA = lanes.x[i];
+        const auto tyA = lanes.y[i];
+
+        const auto a = aA * parentA[i] + bA * parentC[i];
+        const auto b = aA * parentB[i] + bA * parentD[i];
+        const auto c = cA * parentA[i] + dA * parentC[i];
+        const auto d = cA * parentB[i] + dA * parentD[i];
+        const auto parentX = parentA[i] * txA + parentC[i] * tyA + parentTX[i];
+        const auto parentY = parentD[i] * tyA + parentB[i] * txA + parentTY[i];
+        const auto tx = parentX * parentTranslation + txA * localTranslation;
+        const auto ty = parentY * parentTranslation + tyA * localTranslation;
+
+        lanes.a[i] = a;
+        lanes.b[i] = b;
+        lanes.c[i] = c;
+        lanes.d[i] = d;
+        lanes.tx[i] = tx;
+        lanes.ty[i] = ty;
+        lanes.x[i] = tx;
+        lanes.y[i] = ty;
+        lanes.skewX[i] = _atan(-c, d);
+        lanes.skewY[i] = _atan(b, a);
+    }
+
+    // A loop of its own, the constant would otherwise let the compiler split the next loop into a branch per case.
+    for (unsigned i = 0; i < LANE_COUNT; ++i)
+    {
+        lanes.skewX[i] = lanes.skewX[i] == lanes.skewX[i] ? lanes.skewX[i] : 0.f;
+        lanes.skewY[i] = lanes.skewY[i] == lanes.skewY[i] ? lanes.skewY[i] : 0.f;
+    }
+
+    // The scales of Transform::fromMatrix().
+    for (unsigned i = 0; i < LANE_COUNT; ++i)
+    {
+        const auto skewX = lanes.skewX[i];
+        const auto skewY = lanes.skewY[i];
+        const auto a = lanes.a[i];
+        const auto b = lanes.b[i];
+        const auto c = lanes.c[i];
+        const auto d = lanes.d[i];
+
+        float sinX, cosX, sinY, cosY;
+        _sinCos(skewX, sinX, cosX);
+        _sinCos(skewY, sinY, cosY);
+        const auto isCosX = std::fabs(skewX) < PI_Q;
+        const auto isCosY = std::fabs(skewY) < PI_Q;
+        const auto scaleY = (isCosX ? d : -c) / (isCosX ? cosX : sinX);
+        const auto scaleX = (isCosY ? a : b) / (isCosY ? cosY : sinY);
+
+        const auto isPositiveX = lanes.scaleX[i] >= 0.f;
+        const auto isNegativeX = scaleX < 0.f;
+        const auto isPositiveY = lanes.scaleY[i] >= 0.f;
+        const auto isNegativeY = scaleY < 0.f;
+        const auto flipX = (float)(isPositiveX & isNegativeX);
+        const auto flipY = (float)(isPositiveY & isNegativeY);
+
+        lanes.skewX[i] = skewX - PI * flipY;
+        lanes.skewY[i] = skewY - PI * flipX;
+        lanes.scaleX[i] = scaleX * (1.f - 2.f * flipX);
+        lanes.scaleY[i] = scaleY * (1.f - 2.f * flipY);
+    }
+}
+
+void PoseSampler::_computeIK(std::size_t boneIndex, const Transform& ikGlobal, Transform& global, Matrix& globalTransformMatrix, Transform* parentGlobal, Matrix* parentMatrix) const
+{
+    const auto& boneData = *_bones[boneIndex];
+    const auto ikWeight = boneData.weight;
+    const auto x = globalTransformMatrix.a * boneData.length;
+    const auto y = globalTransformMatrix.b * boneData.length;
+
+    if (_ikChains[boneIndex])
+    {
+        const auto lLL = x * x + y * y;
+        const auto lL = std::sqrt(lLL);
+
+        auto dX = global.x - parentGlobal->x;
+        auto dY = global.y - parentGlobal->y;
+        const auto lPP = dX * dX + dY * dY;
+        const auto lP = std::sqrt(lPP);
+
+        dX = ikGlobal.x - parentGlobal->x;
+        dY = ikGlobal.y - parentGlobal->y;
+        const auto lTT = dX * dX + dY * dY;
+        const auto lT = std::sqrt(lTT);
+
+        auto ikRadianA = 0.f;
+        if (lL + lP <= lT || lT + lL <= lP || lT + lP <= lL)
+        {
+            ikRadianA = std::atan2(ikGlobal.y - parentGlobal->y, ikGlobal.x - parentGlobal->x);
+            if (lL + lP > lT && lP < lL)
+            {
+                ikRadianA += PI;
+            }
+        }
+        else
+        {
+            const auto h = (lPP - lLL + lTT) / (2.f * lTT);
+            const auto r = std::sqrt(lPP - h * h * lTT) / lT;
+            const auto hX = parentGlobal->x + (dX * h);
+            const auto hY = parentGlobal->y + (dY * h);
+            const auto rX = -dY * r;
+            const auto rY = dX * r;
+
+            if (boneData.bendPositive)
+            {
+                global.x = hX - rX;
+                global.y = hY - rY;
+            }
+            else
+            {
+                global.x = hX + rX;
+                global.y = hY + rY;
+            }
+
+            ikRadianA = std::atan2(global.y - parentGlobal->y, global.x - parentGlobal->x);
+        }
+
+        ikRadianA = (ikRadianA - parentGlobal->skewY) * ikWeight;
+        parentGlobal->skewX += ikRadianA;
+        parentGlobal->skewY += ikRadianA;
+        global.x = parentGlobal->x + std::cos(parentGlobal->skewY) * lP;
+        global.y = parentGlobal->y + std::sin(parentGlobal->skewY) * lP;
+        parentGlobal->toMatrix(*parentMatrix);
+    }
+
+    const auto ikRadian =
+        (
+            std::atan2(ikGlobal.y - global.y, ikGlobal.x - global.x) -
+            global.skewY * 2.f +
+            std::atan2(y, x)
+        ) * ikWeight;
+
+    global.skewX += ikRadian;
+    global.skewY += ikRadian;
+    global.toMatrix(globalTransformMatrix);
+}
+
+void PoseSampler::_computeIKLane(std::size_t boneIndex, PoseSamplerScratch::BoneLanes* boneLanes, std::size_t blockCount, std::size_t lane) const
+{
+    const auto LANE_COUNT = PoseSamplerScratch::LANE_COUNT;
+    const auto block = lane / LANE_COUNT;
+    const auto blockLane = lane % LANE_COUNT;
+    auto& lanes = boneLanes[boneIndex * blockCount + block];
+
+    Transform ikGlobal, global;
+    Matrix ikMatrix, globalTransformMatrix;
+    _getLane(boneLanes[_ikIndices[boneIndex] * blockCount + block], blockLane, ikGlobal, ikMatrix);
+    _getLane(lanes, blockLane, global, globalTransformMatrix);
+
+    if (_ikChains[boneIndex])
+    {
+        auto& parentLanes = boneLanes[_parentIndices[boneIndex] * blockCount + block];
+        Transform parentGlobal;
+        Matrix parentMatrix;
+        _getLane(parentLanes, blockLane, parentGlobal, parentMatrix);
+        _computeIK(boneIndex, ikGlobal, global, globalTransformMatrix, &parentGlobal, &parentMatrix);
+        _setLane(parentLanes, blockLane, parentGlobal, parentMatrix);
+    }
+    else
+    {
+        _computeIK(boneIndex, ikGlobal, global, globalTransformMatrix, nullptr, nullptr);
+    }
+
+    _setLane(lanes, blockLane, global, globalTransformMatrix);
+}
+
+void PoseSampler::sample(const AnimationData& animation, const float* times, std::size_t count, Matrix* outBoneMatrices, Transform* outBoneGlobals, PoseSamplerScratch& scratch) const
+{
+    const auto iterator = std::find(_animations.cbegin(), _animations.cend(), &animation);
+    if (iterator == _animations.cend())
+    {
+        DRAGONBONES_ASSERT(false, "Argument error.");
+        return;
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    const auto LANE_COUNT = PoseSamplerScratch::LANE_COUNT;
+    const auto& clip = animation.animation ? *animation.animation : animation;
+    const auto& boneTimelines = _boneTimelines[iterator - _animations.cbegin()];
+    const auto timeScale = 1.f / animation.scale;
+    const auto timeToFrameScale = clip.frameCount / clip.duration;
+    const auto boneCount = _bones.size();
+
+    // Resizing keeps the capacity, the scratch only allocates for a larger batch than before.
+    auto& currentTimes = scratch._times;
+    auto& currentPlayTimes = scratch._playTimes;
+    auto& frameIndices = scratch._frameIndices;
+    currentTimes.resize(count);
+    currentPlayTimes.resize(count);
+    frameIndices.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        currentTimes[i] = _getPlayTime(times[i] * timeScale, animation.playTimes, animation.duration, currentPlayTimes[i]) + animation.position;
+        frameIndices[i] = (unsigned)(currentTimes[i] * timeToFrameScale);
+    }
+
+    // Frame lookups and easing branch on the key frames of each instance, one instance at a time.
+    const auto addPose = [&](const BoneTimelineData& timelineData, std::size_t i, Transform& global)
+    {
+        auto timelineTime = currentTimes[i];
+        auto frameIndex = frameIndices[i];
+        if (clip.hasAsynchronyTimeline)
+        {
+            unsigned timelinePlayTimes = 0;
+            timelineTime = _getPlayTime(
+                times[i] * timeScale * (1.f / timelineData.scale) + timelineData.offset * clip.duration,
+                animation.playTimes, animation.duration, timelinePlayTimes
+            ) + animation.position;
+            frameIndex = (unsigned)(timelineTime * timeToFrameScale);
+        }
+
+        Transform pose;
+        _sampleBone(animation, timelineData, timelineTime, frameIndex, currentPlayTimes[i], pose);
+        global.add(pose);
+    };
+
+    if (count < PoseSamplerScratch::BATCH_COUNT_MIN)
+    {
+        auto& globals = scratch._globals;
+        auto& matrices = scratch._matrices;
+        globals.resize(boneCount * count);
+        matrices.resize(boneCount * count);
+
+        for (std::size_t k = 0; k < boneCount; ++k)
+        {
+            const auto& boneData = *_bones[k];
+            const auto timelineData = boneTimelines[k];
+            const auto parentIndex = _parentIndices[k];
+            const auto ikIndex = _ikIndices[k];
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto& global = globals[k * count + i];
+                auto& globalTransformMatrix = matrices[k * count + i];
+                global = boneData.transform;
+                if (timelineData)
+                {
+                    addPose(*timelineData, i, global);
+                }
+
+                if (parentIndex >= 0)
+                {
+                    _updateGlobal(boneData, global, globalTransformMatrix, &globals[parentIndex * count + i], &matrices[parentIndex * count + i]);
+                }
+                else
+                {
+                    _updateGlobal(boneData, global, globalTransformMatrix, nullptr, nullptr);
+                }
+
+                if (ikIndex >= 0)
+                {
+                    const auto isChain = _ikChains[k];
+                    _computeIK(
+                        k, globals[ikIndex * count + i], global, globalTransformMatrix,
+                        isChain ? &globals[parentIndex * count + i] : nullptr, isChain ? &matrices[parentIndex * count + i] : nullptr
+                    );
+                }
+            }
+        }
+
+        if (outBoneMatrices)
+        {
+            std::copy(matrices.cbegin(), matrices.cend(), outBoneMatrices);
+        }
+
+        if (outBoneGlobals)
+        {
+            std::copy(globals.cbegin(), globals.cend(), outBoneGlobals);
+        }
+
+        return;
+    }
+
+    const auto blockCount = (count + LANE_COUNT - 1) / LANE_COUNT;
+    auto& boneLanes = scratch._boneLanes;
+    boneLanes.resize(boneCount * blockCount);
+
+    for (std::size_t k = 0; k < boneCount; ++k)
+    {
+        const auto& boneData = *_bones[k];
+        const auto lanes = boneLanes.data() + k * blockCount;
+
+        const auto timelineData = boneTimelines[k];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Transform global = boneData.transform; // copy
+            if (timelineData)
+            {
+                addPose(*timelineData, i, global);
+            }
+
+            auto& blockLanes = lanes[i / LANE_COUNT];
+            const auto lane = i % LANE_COUNT;
+            blockLanes.x[lane] = global.x;
+            blockLanes.y[lane] = global.y;
+            blockLanes.skewX[lane] = global.skewX;
+            blockLanes.skewY[lane] = global.skewY;
+            blockLanes.scaleX[lane] = global.scaleX;
+            blockLanes.scaleY[lane] = global.scaleY;
+        }
+
+        // Lanes past count repeat the last instance, they run through the block math but are never read back.
+        const auto lastLane = (count - 1) % LANE_COUNT;
+        auto& lastLanes = lanes[blockCount - 1];
+        for (auto lane = lastLane + 1; lane < LANE_COUNT; ++lane)
+        {
+            lastLanes.x[lane] = lastLanes.x[lastLane];
+            lastLanes.y[lane] = lastLanes.y[lastLane];
+            lastLanes.skewX[lane] = lastLanes.skewX[lastLane];
+            lastLanes.skewY[lane] = lastLanes.skewY[lastLane];
+            lastLanes.scaleX[lane] = lastLanes.scaleX[lastLane];
+            lastLanes.scaleY[lane] = lastLanes.scaleY[lastLane];
+        }
+
+        const auto parentIndex = _parentIndices[k];
+        for (std::size_t j = 0; j < blockCount; ++j)
+        {
+            _updateGlobalLanes(boneData, lanes[j], parentIndex >= 0 ? boneLanes.data() + parentIndex * blockCount + j : nullptr);
+        }
+
+        if (_ikIndices[k] >= 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                _computeIKLane(k, boneLanes.data(), blockCount, i);
+            }
+        }
+    }
+
+    // IK may still rotate a parent after its own step, the results are read back once every bone is done.
+    Transform global;
+    Matrix matrix;
+    for (std::size_t k = 0; k < boneCount; ++k)
+    {
+        const auto lanes = boneLanes.data() + k * blockCount;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            _getLane(lanes[i / LANE_COUNT], i % LANE_COUNT, global, matrix);
+            if (outBoneMatrices)
+            {
+                outBoneMatrices[k * count + i] = matrix;
+            }
+
+            if (outBoneGlobals)
+            {
+                outBoneGlobals[k * count + i] = global;
+            }
+        }
+    }
+}
+
+int PoseSampler::getBoneIndex(const std::string& name) const
+{
+    for (std::size_t i = 0, l = _bones.size(); i < l; ++i)
+    {
+        if (_bones[i]->name == name)
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+DRAGONBONES_NAMESPACE_END
@@ -0,0 +1,146 @@
+#ifndef DRAGONBONES_POSE_SAMPLER_H
+#define DRAGONBONES_POSE_SAMPLER_H
+
+#include "../model/ArmatureData.h"
+#include "../model/AnimationData.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+/**
+ * Working memory of PoseSampler::sample(), kept by the caller so sampling does not allocate once it has grown to the
+ * largest batch. One per thread, a thread may pass the same scratch to any number of samplers.
+ */
+class PoseSamplerScratch final
+{
+public:
+    /** Instances sampled together, the global transform math runs over a whole block of lanes at once. */
+    static const unsigned LANE_COUNT = 8;
+    /** Smaller batches run one instance at a time, every block costs the same however few of its lanes are used. */
+    static const unsigned BATCH_COUNT_MIN = 3;
+
+    /** @private One bone of LANE_COUNT instances, the global transform and its matrix as struct of arrays. */
+    class BoneLanes final
+    {
+    public:
+        float x[LANE_COUNT];
+        float y[LANE_COUNT];
+        float skewX[LANE_COUNT];
+        float skewY[LANE_COUNT];
+        float scaleX[LANE_COUNT];
+        float scaleY[LANE_COUNT];
+        float a[LANE_COUNT];
+        float b[LANE_COUNT];
+        float c[LANE_COUNT];
+        float d[LANE_COUNT];
+        float tx[LANE_COUNT];
+        float ty[LANE_COUNT];
+    };
+
+public: // private
+    /** @private Bone major, block j of bone k is at k * blockCount + j. */
+    std::vector<BoneLanes> _boneLanes;
+    /** @private Play time of each lane. */
+    std::vector<float> _times;
+    /** @private */
+    std::vector<unsigned> _playTimes;
+    /** @private Clip frame of each lane, shared by every timeline that is not asynchronous. */
+    std::vector<unsigned> _frameIndices;
+    /** @private Global transforms of batches smaller than BATCH_COUNT_MIN, bone major like the results. */
+    std::vector<Transform> _globals;
+    /** @private */
+    std::vector<Matrix> _matrices;
+
+public:
+    PoseSamplerScratch() {}
+    ~PoseSamplerScratch() {}
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(PoseSamplerScratch);
+};
+
+/**
+ * Evaluates the bone pose of an animation at any time without an Armature, animation states or timeline states.
+ * Bones are in the order of ArmatureData::getSortedBones(). sample() only reads the data, any number of threads
+ * can sample one PoseSampler at once with a PoseSamplerScratch each, as long as the data is not changed or disposed meanwhile.
+ */
+class PoseSampler final
+{
+private:
+    ArmatureData* _armatureData;
+    std::vector<BoneData*> _bones;
+    std::vector<int> _parentIndices;
+    /** Index of the IK target, -1 if the bone does not solve IK. */
+    std::vector<int> _ikIndices;
+    /** Two bone IK rotates the parent as well. */
+    std::vector<bool> _ikChains;
+    std::vector<AnimationData*> _animations;
+    /** Bone timelines of each animation by bone index, nullptr where the animation does not key the bone. */
+    std::vector<std::vector<BoneTimelineData*>> _boneTimelines;
+
+public:
+    explicit PoseSampler(ArmatureData& armatureData);
+    ~PoseSampler();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(PoseSampler);
+
+    /** Wraps time into the play time of a timeline like TimelineState does, without the position. */
+    static float _getPlayTime(float time, unsigned playTimes, float duration, unsigned& currentPlayTimes);
+
+    /** Branch free polynomials so loops over lanes vectorize, within 2e-7 of the std functions for angles of a few turns. */
+    static void _sinCos(float value, float& sin, float& cos);
+    /** atan(y / x), NaN when both are zero. */
+    static float _atan(float y, float x);
+
+    static void _getLane(const PoseSamplerScratch::BoneLanes& lanes, std::size_t lane, Transform& global, Matrix& matrix);
+    static void _setLane(PoseSamplerScratch::BoneLanes& lanes, std::size_t lane, const Transform& global, const Matrix& matrix);
+
+    void _sampleBone(const AnimationData& animation, const BoneTimelineData& timeline, float time, unsigned frameIndex, unsigned playTimes, Transform& pose) const;
+    /** Bone::_updateGlobalTransformMatrix() for one instance. */
+    static void _updateGlobal(const BoneData& boneData, Transform& global, Matrix& globalTransformMatrix, const Transform* parentGlobal, const Matrix* parentMatrix);
+    /** Bone::_updateGlobalTransformMatrix() for a block of lanes. */
+    void _updateGlobalLanes(const BoneData& boneData, PoseSamplerScratch::BoneLanes& lanes, const PoseSamplerScratch::BoneLanes* parentLanes) const;
+    /** Bone::_computeIKA() and Bone::_computeIKB() for one instance, the parent is only used by a chain. */
+    void _computeIK(std::size_t boneIndex, const Transform& ikGlobal, Transform& global, Matrix& globalTransformMatrix, Transform* parentGlobal, Matrix* parentMatrix) const;
+    /** _computeIK() for one lane. */
+    void _computeIKLane(std::size_t boneIndex, PoseSamplerScratch::BoneLanes* boneLanes, std::size_t blockCount, std::size_t lane) const;
+
+public:
+    /**
+     * Poses the bones as an armature of the data playing animation from its start for times[i] seconds at time scale 1,
+     * for count instances at once, without fading and without bone offsets. Results are bone major, bone k of instance i
+     * is at k * count + i. outBoneMatrices and outBoneGlobals, when not nullptr, hold getBoneCount() * count items.
+     * animation has to belong to the armature data.
+     * Frame lookups and easing run per instance, the global transforms of each bone run over PoseSamplerScratch::LANE_COUNT
+     * instances at a time with polynomial sine, cosine and arctangent, so batches of at least that many fill the vector units.
+     * Batches smaller than PoseSamplerScratch::BATCH_COUNT_MIN run one instance at a time with the std functions instead.
+     */
+    void sample(const AnimationData& animation, const float* times, std::size_t count, Matrix* outBoneMatrices, Transform* outBoneGlobals, PoseSamplerScratch& scratch) const;
+
+    /** Poses one instance, see the batch sample(). outBoneMatrices and outBoneGlobals hold getBoneCount() items. */
+    inline void sample(const AnimationData& animation, float time, Matrix* outBoneMatrices, Transform* outBoneGlobals, PoseSamplerScratch& scratch) const
+    {
+        sample(animation, &time, 1, outBoneMatrices, outBoneGlobals, scratch);
+    }
+
+    /** Index into the sampled bones, -1 if there is no bone of that name. */
+    int getBoneIndex(const std::string& name) const;
+
+    inline std::size_t getBoneCount() const
+    {
+        return _bones.size();
+    }
+
+    inline const std::vector<BoneData*>& getBones() const
+    {
+        return _bones;
+    }
+
+    inline const ArmatureData& getArmatureData() const
+    {
+        return *_armatureData;
+    }
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_POSE_SAMPLER_H
@@ -25,17 +25,16 @@ void AnimationTimelineState::_onClear()
 void AnimationTimelineState::update(float time)
 {
     const auto prevPlayTimes = this->_currentPlayTimes;
-    const auto eventDispatcher = this->_armature->_display;
 
     if (!_isStarted && time != 0.f)
     {
         _isStarted = true;
 
-        if (eventDispatcher->hasEvent(EventObject::START))
+        if (this->_armature->_hasEvent(EventObjectType::Start))
         {
             const auto eventObject = BaseObject::borrowObject<EventObject>();
             eventObject->animationState = this->_animationState;
-            this->_armature->_bufferEvent(eventObject, EventObject::START);
+            this->_armature->_bufferEvent(eventObject, EventObjectType::Start);
         }
     }
 
@@ -43,8 +42,8 @@ void AnimationTimelineState::update(float time)
 
     if (prevPlayTimes != this->_currentPlayTimes)
     {
-        const auto eventType = _isCompleted ? EventObject::COMPLETE : EventObject::LOOP_COMPLETE;
-        if (eventDispatcher->hasEvent(eventType))
+        const auto eventType = _isCompleted ? EventObjectType::Complete : EventObjectType::LoopComplete;
+        if (this->_armature->_hasEvent(eventType))
         {
             const auto eventObject = BaseObject::borrowObject<EventObject>();
             eventObject->animationState = this->_animationState;
@@ -230,7 +229,7 @@ void BoneTimelineState::_onUpdateFrame(bool isUpdate)
             }
         }
 
-        bone->invalidUpdate();
+        bone->_transformDirty = Bone::BoneTransformDirty::All;
     }
 }
 
@@ -271,7 +270,7 @@ void BoneTimelineState::update(float time)
         const auto fadeProgress = this->_animationState->_fadeProgress;
         if (fadeProgress < 1.f)
         {
-            bone->invalidUpdate();
+            bone->_transformDirty = Bone::BoneTransformDirty::All;
         }
     }
 }
@@ -466,6 +465,47 @@ void SlotTimelineState::update(float time)
     }
 }
 
+void SlotTimelineState::_cacheState(std::size_t cacheFrameIndex)
+{
+    auto& cachedStates = this->_timeline->cachedStates;
+    if (cachedStates[cacheFrameIndex] || this->_animationState->_isDisabled(*slot))
+    {
+        return;
+    }
+
+    SlotTimelineData::cacheState(cachedStates, cacheFrameIndex, slot->getDisplayIndex(), slot->_colorTransform);
+}
+
+bool SlotTimelineState::_applyCachedState(std::size_t cacheFrameIndex)
+{
+    const auto cachedState = this->_timeline->cachedStates[cacheFrameIndex];
+    if (!cachedState)
+    {
+        return false;
+    }
+
+    this->_currentFrame = nullptr; // Arrive at frame again on next update.
+
+    if (this->_animationState->_isDisabled(*slot))
+    {
+        return true;
+    }
+
+    if (slot->getDisplayIndex() != cachedState->displayIndex)
+    {
+        slot->_setDisplayIndex(cachedState->displayIndex);
+        slot->_updateMeshData(true);
+    }
+
+    if (!cachedState->colorEquals(*_slotColor))
+    {
+        *_slotColor = cachedState->color; // copy
+        slot->_colorDirty = true;
+    }
+
+    return true;
+}
+
 FFDTimelineState::FFDTimelineState() :
     _durationFFDFrame(nullptr)
 {
@@ -484,6 +524,7 @@ void FFDTimelineState::_onClear()
 
     _tweenFFD = TweenType::None;
     _slotFFDVertices = nullptr;
+    _helpRuns.clear();
 
     if (_durationFFDFrame)
     {
@@ -499,30 +540,62 @@ void FFDTimelineState::_onFadeIn()
     _slotFFDVertices = &slot->_ffdVertices;
 
     _durationFFDFrame = BaseObject::borrowObject<ExtensionFrameData>();
-    _durationFFDFrame->tweens.resize(_slotFFDVertices->size(), 0.f);
-    _ffdVertices.resize(_slotFFDVertices->size(), 0.f);
 }
 
 void FFDTimelineState::_onArriveAtFrame(bool isUpdate)
 {
     TweenTimelineState::_onArriveAtFrame(isUpdate);
 
+    const auto& currentFrame = *this->_currentFrame;
+    auto& runs = _durationFFDFrame->runs;
+
+    // The runs of the last key frame, _ffdVertices is laid out by them.
+    _helpRuns.swap(runs);
     _tweenFFD = TweenType::None;
 
     if (this->_tweenEasing != NO_TWEEN || this->_curve)
     {
-        _tweenFFD = this->_updateExtensionKeyFrame(*this->_currentFrame, *this->_currentFrame->next, *_durationFFDFrame);
+        _tweenFFD = this->_updateExtensionKeyFrame(currentFrame, *currentFrame.next, *_durationFFDFrame);
+    }
+    else
+    {
+        runs = currentFrame.runs; // copy
+        _durationFFDFrame->tweens.assign(currentFrame.tweens.size(), 0.f);
+    }
+
+    if (_ffdVertices.size() != _durationFFDFrame->tweens.size() || runs != _helpRuns)
+    {
+        _ffdVertices.resize(_durationFFDFrame->tweens.size(), 0.f);
+
+        if (_tweenFFD == TweenType::None)
+        {
+            _tweenFFD = TweenType::Once;
+        }
     }
 
     if (_tweenFFD == TweenType::None)
     {
-        const auto& currentFFDVertices = this->_currentFrame->tweens;
-        for (std::size_t i = 0, l = currentFFDVertices.size(); i < l; ++i)
+        if (slot->_ffdRuns != runs)
+        {
+            _tweenFFD = TweenType::Once;
+        }
+        else
         {
-            if ((*_slotFFDVertices)[i] != currentFFDVertices[i])
+            // Without a tween the vertices are the ones of the current key frame.
+            std::fill(_ffdVertices.begin(), _ffdVertices.end(), 0.f);
+            currentFrame.addTweens(runs, 1.f, _ffdVertices.data());
+
+            const auto& slotFFDVertices = *_slotFFDVertices;
+            for (std::size_t i = 0, iV = 0, l = runs.size(); i < l && _tweenFFD == TweenType::None; i += 2)
             {
-                _tweenFFD = TweenType::Once;
-                break;
+                for (std::size_t iS = runs[i], lS = runs[i + 1]; iS < lS; ++iS, ++iV)
+                {
+                    if (slotFFDVertices[iS] != _ffdVertices[iV])
+                    {
+                        _tweenFFD = TweenType::Once;
+                        break;
+                    }
+                }
             }
         }
     }
@@ -539,13 +612,15 @@ void FFDTimelineState::_onUpdateFrame(bool isUpdate)
             _tweenFFD = TweenType::None;
         }
 
-        const auto& currentFFDVertices = this->_currentFrame->tweens;
-        const auto& nextFFDVertices = _durationFFDFrame->tweens;
-        for (std::size_t i = 0, l = currentFFDVertices.size(); i < l; ++i)
+        const auto& currentFrame = *this->_currentFrame;
+        const auto& durationFFDVertices = _durationFFDFrame->tweens;
+        for (std::size_t i = 0, l = durationFFDVertices.size(); i < l; ++i)
         {
-            _ffdVertices[i] = currentFFDVertices[i] + nextFFDVertices[i] * this->_tweenProgress;
+            _ffdVertices[i] = durationFFDVertices[i] * this->_tweenProgress;
         }
 
+        currentFrame.addTweens(_durationFFDFrame->runs, 1.f, _ffdVertices.data());
+
         slot->_ffdDirty = true;
     }
 }
@@ -557,21 +632,51 @@ void FFDTimelineState::update(float time)
     const auto weight = this->_animationState->_weightResult;
     if (weight > 0.f)
     {
+        auto& slotFFDVertices = *_slotFFDVertices;
+        const auto& runs = _durationFFDFrame->runs;
+
         if (slot->_blendIndex == 0)
         {
-            for (std::size_t i = 0, l = _ffdVertices.size(); i < l; ++i)
+            // Clear vertices left deformed outside of this timeline's runs.
+            if (slot->_ffdRuns != runs)
             {
-                (*_slotFFDVertices)[i] = _ffdVertices[i] * weight;
+                for (std::size_t i = 0, l = slot->_ffdRuns.size(); i < l; i += 2)
+                {
+                    std::fill(slotFFDVertices.begin() + slot->_ffdRuns[i], slotFFDVertices.begin() + slot->_ffdRuns[i + 1], 0.f);
+                }
+
+                slot->_ffdRuns = runs; // copy
+                slot->_ffdDirty = true;
+            }
+
+            for (std::size_t i = 0, iV = 0, l = runs.size(); i < l; i += 2)
+            {
+                for (std::size_t iS = runs[i], lS = runs[i + 1]; iS < lS; ++iS, ++iV)
+                {
+                    slotFFDVertices[iS] = _ffdVertices[iV] * weight;
+                }
             }
         }
         else
         {
-            for (std::size_t i = 0, l = _ffdVertices.size(); i < l; ++i)
+            for (std::size_t i = 0, iV = 0, l = runs.size(); i < l; i += 2)
             {
-                (*_slotFFDVertices)[i] += _ffdVertices[i] * weight;
+                for (std::size_t iS = runs[i], lS = runs[i + 1]; iS < lS; ++iS, ++iV)
+                {
+                    slotFFDVertices[iS] += _ffdVertices[iV] * weight;
+                }
+            }
+
+            if (!runs.empty() && slot->_ffdRuns != runs)
+            {
+                ExtensionFrameData::unionRuns(slot->_ffdRuns, runs, _helpRuns);
+                slot->_ffdRuns.swap(_helpRuns);
             }
         }
 
+        slot->_ffdBegin = slot->_ffdRuns.empty() ? 0 : slot->_ffdRuns.front();
+        slot->_ffdEnd = slot->_ffdRuns.empty() ? 0 : slot->_ffdRuns.back();
+
         slot->_blendIndex++;
 
         const auto fadeProgress = this->_animationState->_fadeProgress;
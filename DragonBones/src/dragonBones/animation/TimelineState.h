@@ -91,6 +91,12 @@ protected:
     void _onArriveAtFrame(bool isUpdate) override;
     void _onUpdateFrame(bool isUpdate) override;
 
+public:
+    /** @private */
+    void _cacheState(std::size_t cacheFrameIndex);
+    /** @private */
+    bool _applyCachedState(std::size_t cacheFrameIndex);
+
 public:
     void fadeOut() override;
     void update(float time) override;
@@ -108,6 +114,7 @@ private:
     std::vector<float>* _slotFFDVertices;
     ExtensionFrameData* _durationFFDFrame;
     std::vector<float> _ffdVertices;
+    std::vector<unsigned> _helpRuns;
 
 public:
     FFDTimelineState();
@@ -1,47 +1,498 @@
 #include "WorldClock.h"
+#include "../armature/Armature.h"
+#include "../armature/Slot.h"
+#include "../core/WorkerPool.h"
+#include <chrono>
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+const unsigned WorldClock::MAX_UPDATE_TIER;
+const WorldClock::Handle WorldClock::INVALID_HANDLE;
 WorldClock WorldClock::clock;
+std::atomic<unsigned> WorldClock::_sharedPoseTickCount(0);
 
 WorldClock::WorldClock():
     time(0.f),
     timeScale(1.f),
-    _animatebles()
+    cullingTest(),
+    updateTierTest(),
+    timeBudget(0.f),
+    poseSharing(false),
+    _threadCount(0),
+    _tickCount(0),
+    _deferredCount(0),
+    _deferredCost(0.f),
+    _averageCost(0.f),
+    _animatebles(),
+    _animatebleSlots(),
+    _sleepingSlots(),
+    _slotIndices(),
+    _slotSleeping(),
+    _slotGenerations(),
+    _slotArmatures(),
+    _slotTiers(),
+    _slotPassedTimes(),
+    _slotPriorities(),
+    _slotDeferredTicks(),
+    _slotCosts(),
+    _dueHandles(),
+    _freeSlots(),
+    _slotMap(),
+    _workerPool(nullptr),
+    _armatures(),
+    _groupedArmatures(),
+    _groups(),
+    _groupParents(),
+    _dataGroups()
 {
 }
 WorldClock::~WorldClock()
 {
     clear();
+
+    if (_workerPool)
+    {
+        delete _workerPool;
+        _workerPool = nullptr;
+    }
+}
+
+float WorldClock::_getCost(unsigned slot) const
+{
+    return _slotCosts[slot] >= 0.f ? _slotCosts[slot] : _averageCost;
+}
+
+std::size_t WorldClock::_findGroup(std::size_t task)
+{
+    while (_groupParents[task] != task)
+    {
+        _groupParents[task] = _groupParents[_groupParents[task]];
+        task = _groupParents[task];
+    }
+
+    return task;
+}
+
+void WorldClock::_joinGroups(const Armature& armature, std::size_t task)
+{
+    const auto& armatureData = armature.getArmatureData();
+    if (armatureData.cacheFrameRate > 0)
+    {
+        const auto iterator = _dataGroups.find(&armatureData);
+        if (iterator == _dataGroups.end())
+        {
+            _dataGroups[&armatureData] = task;
+        }
+        else
+        {
+            _groupParents[_findGroup(task)] = _findGroup(iterator->second);
+        }
+    }
+
+    for (const auto slot : armature.getSlots())
+    {
+        const auto childArmature = slot->getChildArmature();
+        if (childArmature)
+        {
+            _joinGroups(*childArmature, task);
+        }
+    }
+}
+
+void WorldClock::_advanceDue()
+{
+    _deferredCount = 0;
+    _deferredCost = 0.f;
+
+    if (timeBudget > 0.f)
+    {
+        // Waiting raises the priority, so low priorities still advance under a steady load.
+        std::stable_sort(_dueHandles.begin(), _dueHandles.end(), [this](Handle a, Handle b)
+        {
+            unsigned slotA = 0, slotB = 0;
+            _getSlot(a, slotA);
+            _getSlot(b, slotB);
+            return _slotPriorities[slotA] + (int)_slotDeferredTicks[slotA] > _slotPriorities[slotB] + (int)_slotDeferredTicks[slotB];
+        });
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    auto parallelCost = 0.f;
+    std::size_t advancedCount = 0;
+
+    for (const auto handle : _dueHandles)
+    {
+        unsigned slot = 0;
+        if (!_getSlot(handle, slot) || _slotSleeping[slot]) // Removed by an earlier one.
+        {
+            continue;
+        }
+
+        const auto animateble = _animatebles[_slotIndices[slot]];
+        const auto armature = _slotArmatures[slot];
+        const auto isParallel = armature && _workerPool && armature->_isThreadSafe();
+
+        if (timeBudget > 0.f)
+        {
+            auto cost = _getCost(slot);
+            if (isParallel)
+            {
+                cost /= _threadCount + 1;
+            }
+
+            const auto usedTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count() + parallelCost;
+            if (advancedCount > 0 && usedTime + cost > timeBudget)
+            {
+                _slotDeferredTicks[slot]++;
+                _deferredCount++;
+                _deferredCost += cost;
+                continue;
+            }
+
+            if (isParallel)
+            {
+                parallelCost += cost;
+            }
+        }
+
+        const auto passedTime = _slotPassedTimes[slot];
+        _slotPassedTimes[slot] = 0.f;
+        _slotDeferredTicks[slot] = 0;
+        advancedCount++;
+
+        if (armature && cullingTest)
+        {
+            armature->setCulled(cullingTest(*armature));
+        }
+
+        if (isParallel)
+        {
+            _armatures.push_back(std::make_tuple(armature, passedTime, slot));
+        }
+        else if (timeBudget > 0.f)
+        {
+            const auto advanceStartTime = std::chrono::steady_clock::now();
+            animateble->advanceTime(passedTime);
+            const auto cost = std::chrono::duration<float>(std::chrono::steady_clock::now() - advanceStartTime).count();
+
+            if (_getSlot(handle, slot))
+            {
+                _slotCosts[slot] = cost;
+            }
+
+            _averageCost += (cost - _averageCost) * 0.1f;
+        }
+        else
+        {
+            animateble->advanceTime(passedTime);
+        }
+    }
+
+    _dueHandles.clear();
+
+    if (!_armatures.empty())
+    {
+        _advanceArmatures();
+    }
+}
+
+void WorldClock::_advanceArmatures()
+{
+    // Armatures reaching the same cached data, child armatures included, write the same cache frames, each group is advanced by one task.
+    for (std::size_t i = 0, l = _armatures.size(); i < l; ++i)
+    {
+        _groupParents.push_back(i);
+        _joinGroups(*std::get<0>(_armatures[i]), i);
+    }
+
+    for (std::size_t i = 0, l = _armatures.size(); i < l; ++i)
+    {
+        _groupParents[i] = _findGroup(i);
+        _groupedArmatures.push_back(i);
+    }
+
+    std::stable_sort(_groupedArmatures.begin(), _groupedArmatures.end(), [this](std::size_t a, std::size_t b)
+    {
+        return _groupParents[a] < _groupParents[b];
+    });
+
+    for (std::size_t i = 0, l = _groupedArmatures.size(); i < l; ++i)
+    {
+        if (i == 0 || _groupParents[_groupedArmatures[i]] != _groupParents[_groupedArmatures[i - 1]])
+        {
+            _groups.push_back(i);
+        }
+    }
+
+    _groups.push_back(_groupedArmatures.size());
+
+    // The calling thread works on tasks as well, it gets its own state back afterwards.
+    const auto sharedPoseTick = Armature::_sharedPoseTick;
+    _workerPool->parallelFor(_groups.size() - 1, [this, sharedPoseTick](std::size_t index)
+    {
+        const auto prevDeferActionAndEvent = Armature::_deferActionAndEvent;
+        const auto prevSharedPoseTick = Armature::_sharedPoseTick;
+        Armature::_deferActionAndEvent = true;
+        Armature::_sharedPoseTick = sharedPoseTick;
+
+        for (auto i = _groups[index], l = _groups[index + 1]; i < l; ++i)
+        {
+            const auto& task = _armatures[_groupedArmatures[i]];
+            if (timeBudget > 0.f)
+            {
+                const auto startTime = std::chrono::steady_clock::now();
+                std::get<0>(task)->advanceTime(std::get<1>(task));
+                _slotCosts[std::get<2>(task)] = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+            }
+            else
+            {
+                std::get<0>(task)->advanceTime(std::get<1>(task));
+            }
+        }
+
+        Armature::_deferActionAndEvent = prevDeferActionAndEvent;
+        Armature::_sharedPoseTick = prevSharedPoseTick;
+    });
+
+    for (const auto& task : _armatures)
+    {
+        if (timeBudget > 0.f)
+        {
+            _averageCost += (_slotCosts[std::get<2>(task)] - _averageCost) * 0.1f;
+        }
+
+        std::get<0>(task)->_flushActionAndEvent();
+    }
+
+    _armatures.clear();
+    _groupedArmatures.clear();
+    _groups.clear();
+    _groupParents.clear();
+    _dataGroups.clear();
+}
+
+WorldClock::Handle WorldClock::_getHandle(unsigned slot) const
+{
+    return ((Handle)_slotGenerations[slot] << 32) | slot;
+}
+
+bool WorldClock::_getSlot(Handle handle, unsigned& slot) const
+{
+    slot = (unsigned)(handle & 0xFFFFFFFF);
+    return
+        slot < _slotGenerations.size() && _slotGenerations[slot] == (unsigned)(handle >> 32) &&
+        (_slotSleeping[slot] || (_slotIndices[slot] < _animatebles.size() && _animatebles[_slotIndices[slot]]));
+}
+
+void WorldClock::_removeSlot(unsigned slot)
+{
+    if (_slotSleeping[slot])
+    {
+        const auto index = _slotIndices[slot];
+        _sleepingSlots[index] = _sleepingSlots.back();
+        _slotIndices[_sleepingSlots[index]] = index;
+        _sleepingSlots.pop_back();
+
+        _slotSleeping[slot] = false;
+        _slotMap.erase(static_cast<IAnimateble*>(_slotArmatures[slot]));
+    }
+    else
+    {
+        auto& animateble = _animatebles[_slotIndices[slot]];
+        _slotMap.erase(animateble);
+        animateble = nullptr; // advanceTime() compacts.
+    }
+
+    if (_slotArmatures[slot] && _slotArmatures[slot]->_clock == this)
+    {
+        _slotArmatures[slot]->_clock = nullptr;
+    }
+
+    _slotArmatures[slot] = nullptr;
+    _slotGenerations[slot]++;
+    _freeSlots.push_back(slot);
+}
+
+void WorldClock::_moveAnimateble(std::size_t from, std::size_t to)
+{
+    const auto slot = _animatebleSlots[from];
+    _animatebles[to] = _animatebles[from];
+    _animatebleSlots[to] = slot;
+    _slotIndices[slot] = to;
+}
+
+void WorldClock::_sleep(unsigned slot)
+{
+    _animatebles[_slotIndices[slot]] = nullptr; // advanceTime() compacts.
+
+    _slotSleeping[slot] = true;
+    _slotIndices[slot] = _sleepingSlots.size();
+    _sleepingSlots.push_back(slot);
+}
+
+void WorldClock::_wakeUp(Armature* armature)
+{
+    const auto iterator = _slotMap.find(armature);
+    if (iterator == _slotMap.end() || !_slotSleeping[iterator->second])
+    {
+        return;
+    }
+
+    const auto slot = iterator->second;
+    const auto index = _slotIndices[slot];
+    _sleepingSlots[index] = _sleepingSlots.back();
+    _slotIndices[_sleepingSlots[index]] = index;
+    _sleepingSlots.pop_back();
+
+    _slotSleeping[slot] = false;
+    _slotIndices[slot] = _animatebles.size();
+    _animatebles.push_back(armature);
+    _animatebleSlots.push_back(slot);
 }
 
 bool WorldClock::contains(const IAnimateble* value) const
 {
-    return std::find(_animatebles.cbegin(), _animatebles.cend(), value) != _animatebles.cend();
+    return _slotMap.find(value) != _slotMap.end();
 }
 
-void WorldClock::add(IAnimateble* value)
+bool WorldClock::contains(Handle handle) const
 {
-    if (std::find(_animatebles.begin(), _animatebles.end(), value) == _animatebles.end())
+    unsigned slot = 0;
+    return _getSlot(handle, slot);
+}
+
+WorldClock::Handle WorldClock::add(IAnimateble* value)
+{
+    if (!value)
+    {
+        return INVALID_HANDLE;
+    }
+
+    const auto iterator = _slotMap.find(value);
+    if (iterator != _slotMap.end())
+    {
+        return _getHandle(iterator->second);
+    }
+
+    unsigned slot = 0;
+    if (!_freeSlots.empty())
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
     {
-        _animatebles.push_back(value);
+        slot = (unsigned)_slotIndices.size();
+        _slotIndices.push_back(0);
+        _slotSleeping.push_back(false);
+        _slotGenerations.push_back(1);
+        _slotTiers.push_back(0);
+        _slotPassedTimes.push_back(0.f);
+        _slotPriorities.push_back(0);
+        _slotDeferredTicks.push_back(0);
+        _slotCosts.push_back(-1.f);
+        _slotArmatures.push_back(nullptr);
     }
+
+    _slotTiers[slot] = 0;
+    _slotPassedTimes[slot] = 0.f;
+    _slotPriorities[slot] = 0;
+    _slotDeferredTicks[slot] = 0;
+    _slotCosts[slot] = -1.f;
+    _slotArmatures[slot] = dynamic_cast<Armature*>(value);
+
+    if (_slotArmatures[slot])
+    {
+        _slotArmatures[slot]->_clock = this;
+    }
+
+    _slotIndices[slot] = _animatebles.size();
+    _animatebles.push_back(value);
+    _animatebleSlots.push_back(slot);
+    _slotMap[value] = slot;
+
+    return _getHandle(slot);
 }
 
 void WorldClock::remove(IAnimateble* value)
 {
-    const auto iterator = std::find(_animatebles.begin(), _animatebles.end(), value);
-    if (iterator != _animatebles.end())
+    const auto iterator = _slotMap.find(value);
+    if (iterator != _slotMap.end())
     {
-        *iterator = nullptr;
+        _removeSlot(iterator->second);
+    }
+}
+
+void WorldClock::remove(Handle handle)
+{
+    unsigned slot = 0;
+    if (_getSlot(handle, slot))
+    {
+        _removeSlot(slot);
     }
 }
 
 void WorldClock::clear()
 {
-    for (auto animateble : _animatebles)
+    for (std::size_t i = 0, l = _animatebles.size(); i < l; ++i)
+    {
+        if (_animatebles[i])
+        {
+            _removeSlot(_animatebleSlots[i]);
+        }
+    }
+
+    while (!_sleepingSlots.empty())
+    {
+        _removeSlot(_sleepingSlots.back());
+    }
+}
+
+unsigned WorldClock::getUpdateTier(Handle handle) const
+{
+    unsigned slot = 0;
+    return _getSlot(handle, slot) ? _slotTiers[slot] : 0;
+}
+
+void WorldClock::setUpdateTier(Handle handle, unsigned tier)
+{
+    unsigned slot = 0;
+    if (_getSlot(handle, slot))
+    {
+        _slotTiers[slot] = std::min(tier, MAX_UPDATE_TIER);
+    }
+}
+
+void WorldClock::setUpdateTier(IAnimateble* value, unsigned tier)
+{
+    const auto iterator = _slotMap.find(value);
+    if (iterator != _slotMap.end())
+    {
+        _slotTiers[iterator->second] = std::min(tier, MAX_UPDATE_TIER);
+    }
+}
+
+int WorldClock::getPriority(Handle handle) const
+{
+    unsigned slot = 0;
+    return _getSlot(handle, slot) ? _slotPriorities[slot] : 0;
+}
+
+void WorldClock::setPriority(Handle handle, int priority)
+{
+    unsigned slot = 0;
+    if (_getSlot(handle, slot))
+    {
+        _slotPriorities[slot] = priority;
+    }
+}
+
+void WorldClock::setPriority(IAnimateble* value, int priority)
+{
+    const auto iterator = _slotMap.find(value);
+    if (iterator != _slotMap.end())
     {
-        animateble = nullptr;
+        _slotPriorities[iterator->second] = priority;
     }
 }
 
@@ -70,13 +521,36 @@ void WorldClock::advanceTime(float passedTime)
         for (; i < l; ++i)
         {
             const auto animateble = _animatebles[i];
-            if (animateble)
+            const auto armature = animateble ? _slotArmatures[_animatebleSlots[i]] : nullptr;
+
+            // Sleeping armatures neither advance nor accumulate time, they leave the ticked animatebles until Armature::wakeUp().
+            if (armature && armature->getSleeping())
+            {
+                _sleep(_animatebleSlots[i]);
+            }
+            else if (animateble)
             {
-                animateble->advanceTime(passedTime);
+                const auto slot = _animatebleSlots[i];
+                if (armature && updateTierTest)
+                {
+                    _slotTiers[slot] = std::min(updateTierTest(*armature), MAX_UPDATE_TIER);
+                }
+
+                _slotPassedTimes[slot] += passedTime;
 
+                // The slot staggers animatebles of the same tier across its ticks, deferred ones retry every tick.
+                if (_slotDeferredTicks[slot] > 0 || ((_tickCount + slot) & ((1u << _slotTiers[slot]) - 1)) == 0)
+                {
+                    _dueHandles.push_back(_getHandle(slot));
+                }
+            }
+
+            // Removed by a test callback is compacted as well.
+            if (_animatebles[i])
+            {
                 if (r > 0)
                 {
-                    _animatebles[i - r] = animateble;
+                    _moveAnimateble(i, i - r);
                 }
             }
             else
@@ -91,10 +565,9 @@ void WorldClock::advanceTime(float passedTime)
 
             for (; i < l; ++i)
             {
-                const auto animateble = _animatebles[i];
-                if (animateble)
+                if (_animatebles[i])
                 {
-                    _animatebles[i - r] = animateble;
+                    _moveAnimateble(i, i - r);
                 }
                 else
                 {
@@ -103,7 +576,52 @@ void WorldClock::advanceTime(float passedTime)
             }
 
             _animatebles.resize(l - r);
+            _animatebleSlots.resize(l - r);
+        }
+
+        _tickCount++;
+
+        // Nested clocks restore the pose sharing tick of their parent clock.
+        const auto prevSharedPoseTick = Armature::_sharedPoseTick;
+        if (poseSharing)
+        {
+            auto sharedPoseTick = ++_sharedPoseTickCount;
+            while (sharedPoseTick == 0)
+            {
+                sharedPoseTick = ++_sharedPoseTickCount;
+            }
+
+            Armature::_sharedPoseTick = sharedPoseTick;
+        }
+        else
+        {
+            Armature::_sharedPoseTick = 0;
         }
+
+        _advanceDue();
+
+        Armature::_sharedPoseTick = prevSharedPoseTick;
+    }
+}
+
+void WorldClock::setThreadCount(unsigned value)
+{
+    if (_threadCount == value)
+    {
+        return;
+    }
+
+    _threadCount = value;
+
+    if (_workerPool)
+    {
+        delete _workerPool;
+        _workerPool = nullptr;
+    }
+
+    if (_threadCount > 0)
+    {
+        _workerPool = new WorkerPool(_threadCount);
     }
 }
 
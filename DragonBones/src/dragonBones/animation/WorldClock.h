@@ -3,19 +3,77 @@
 
 #include "../core/DragonBones.h"
 #include "IAnimateble.h"
+#include <unordered_map>
+#include <atomic>
 
 DRAGONBONES_NAMESPACE_BEGIN
+
+class Armature;
+class ArmatureData;
+class WorkerPool;
+
 class WorldClock final : public IAnimateble
 {
 public:
+    static const unsigned MAX_UPDATE_TIER = 16;
+    /** Returned by add(), it stays valid until the animateble is removed, INVALID_HANDLE never refers to one. */
+    typedef unsigned long long Handle;
+
+    static const Handle INVALID_HANDLE = 0;
     static WorldClock clock;
 
+private:
+    /** Shared by all clocks, so armatures of clocks on other threads never take a pose of this tick. */
+    static std::atomic<unsigned> _sharedPoseTickCount;
+
 public:
     float time;
     float timeScale;
+    /** Called for each armature before it advances, returning true culls it for this tick. See Armature::setCulled(). */
+    std::function<bool(Armature& armature)> cullingTest;
+    /** Called for each armature every tick, the result replaces its update tier. See setUpdateTier(). */
+    std::function<unsigned(Armature& armature)> updateTierTest;
+    /**
+     * Seconds of CPU time per tick, 0 disables. Due animatebles advance by priority while their estimated cost fits,
+     * the rest wait for the next tick with their time accumulated. At least one animateble advances per tick.
+     */
+    float timeBudget;
+    /**
+     * Armatures of the same data and skin that play the same animation at the same cache frame share the pose evaluated
+     * by the first of them in a tick. Only for armatures drawn through RenderBatchBuilder, see Armature::getPoseSource(),
+     * armatures with slots that update display nodes (not thread safe) never take the pose of another.
+     */
+    bool poseSharing;
 
 private:
+    unsigned _threadCount;
+    unsigned _tickCount;
+    std::size_t _deferredCount;
+    float _deferredCost;
+    float _averageCost;
     std::vector<IAnimateble*> _animatebles;
+    std::vector<unsigned> _animatebleSlots;
+    /** Slots of sleeping armatures, kept out of _animatebles until they wake up so a tick only visits awake ones. */
+    std::vector<unsigned> _sleepingSlots;
+    /** Index into _animatebles, or into _sleepingSlots while _slotSleeping is set. */
+    std::vector<std::size_t> _slotIndices;
+    std::vector<bool> _slotSleeping;
+    std::vector<unsigned> _slotGenerations;
+    std::vector<Armature*> _slotArmatures;
+    std::vector<unsigned> _slotTiers;
+    std::vector<float> _slotPassedTimes;
+    std::vector<int> _slotPriorities;
+    std::vector<unsigned> _slotDeferredTicks;
+    std::vector<float> _slotCosts;
+    std::vector<Handle> _dueHandles;
+    std::vector<unsigned> _freeSlots;
+    std::unordered_map<const IAnimateble*, unsigned> _slotMap;
+    WorkerPool* _workerPool;
+    std::vector<std::tuple<Armature*, float, unsigned>> _armatures;
+    std::vector<std::size_t> _groupedArmatures;
+    std::vector<std::size_t> _groups;
+    std::vector<std::size_t> _groupParents;
+    std::unordered_map<const ArmatureData*, std::size_t> _dataGroups;
 
 public:
     WorldClock();
@@ -23,12 +81,60 @@ public:
 
     virtual void advanceTime(float passedTime) override;
     bool contains(const IAnimateble* value) const;
-    void add(IAnimateble* value);
+    bool contains(Handle handle) const;
+    Handle add(IAnimateble* value);
     void remove(IAnimateble* value);
+    void remove(Handle handle);
     void clear();
+    /** @private Moves a sleeping armature back to the ticked animatebles, see Armature::wakeUp(). */
+    void _wakeUp(Armature* armature);
+    unsigned getUpdateTier(Handle handle) const;
+    /**
+     * Tier n advances every 2^n ticks by the time accumulated meanwhile, 0 advances every tick.
+     * Animatebles of a tier are spread over its ticks by their handle, so the cost per tick stays flat.
+     */
+    void setUpdateTier(Handle handle, unsigned tier);
+    void setUpdateTier(IAnimateble* value, unsigned tier);
+    int getPriority(Handle handle) const;
+    /** Higher priorities advance first under timeBudget, each tick spent waiting adds one. */
+    void setPriority(Handle handle, int priority);
+    void setPriority(IAnimateble* value, int priority);
+
+    /** Animatebles deferred by timeBudget in the last tick. */
+    inline std::size_t getDeferredCount() const
+    {
+        return _deferredCount;
+    }
+    /** Estimated seconds of work deferred by timeBudget in the last tick. */
+    inline float getDeferredCost() const
+    {
+        return _deferredCost;
+    }
+
+    inline unsigned getThreadCount() const
+    {
+        return _threadCount;
+    }
+    /**
+     * Armatures are advanced on threadCount extra threads, events and actions are dispatched afterwards on the calling thread in clock order.
+     * Only armatures whose slots, child armatures included, are thread safe (e.g. built by CCFactory::buildArmatureBatchDisplay) go to the workers,
+     * the others advance on the calling thread. Armatures reaching the same cached ArmatureData advance on the same thread.
+     */
+    void setThreadCount(unsigned value);
 
 private:
     DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(WorldClock);
+
+    Handle _getHandle(unsigned slot) const;
+    bool _getSlot(Handle handle, unsigned& slot) const;
+    void _removeSlot(unsigned slot);
+    void _moveAnimateble(std::size_t from, std::size_t to);
+    void _sleep(unsigned slot);
+    float _getCost(unsigned slot) const;
+    std::size_t _findGroup(std::size_t task);
+    void _joinGroups(const Armature& armature, std::size_t task);
+    void _advanceDue();
+    void _advanceArmatures();
 };
 
 DRAGONBONES_NAMESPACE_END
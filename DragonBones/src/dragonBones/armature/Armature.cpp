@@ -1,16 +1,28 @@
 #include "Armature.h"
 #include "Bone.h"
 #include "Slot.h"
+#include "MeshDeformer.h"
+#include "PoseSnapshot.h"
 #include "../animation/Animation.h"
+#include "../animation/WorldClock.h"
 #include "../events/EventObject.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
 IEventDispatcher* Armature::soundEventManager = nullptr;
+MeshDeformer* Armature::meshDeformer = nullptr;
+thread_local bool Armature::_deferActionAndEvent = false;
+thread_local unsigned Armature::_sharedPoseTick = 0;
 
 Armature::Armature() :
+    _cacheAnimationData(nullptr),
     _animation(nullptr),
-    _display(nullptr)
+    _display(nullptr),
+    _poseSource(nullptr),
+    _meshDeformer(nullptr),
+    _meshDeformerIndex(0),
+    _clock(nullptr),
+    _poseSnapshots(nullptr)
 {
     _onClear();
 }
@@ -23,8 +35,39 @@ void Armature::_onClear()
 {
     userData = nullptr;
 
+    _setPoseSource(nullptr);
+
+    for (const auto follower : _poseFollowers)
+    {
+        follower->_poseSource = nullptr;
+    }
+
+    if (_cacheAnimationData && !_cacheAnimationData->sharedPoses.empty())
+    {
+        auto& sharedPoses = _cacheAnimationData->sharedPoses;
+        std::replace(sharedPoses.begin(), sharedPoses.end(), this, (Armature*)nullptr);
+    }
+
+    if (_meshDeformer)
+    {
+        _meshDeformer->_removeArmature(this);
+    }
+
+    if (_clock)
+    {
+        _clock->remove(this);
+        _clock = nullptr;
+    }
+
+    if (_poseSnapshots)
+    {
+        delete _poseSnapshots;
+        _poseSnapshots = nullptr;
+    }
+
     _bonesDirty = false;
     _cacheFrameIndex = -1;
+    _cacheAnimationData = nullptr;
     _delayAdvanceTime = -1.f;
     _armatureData = nullptr;
     _skinData = nullptr;
@@ -45,10 +88,22 @@ void Armature::_onClear()
     _parent = nullptr;
     _action = nullptr;
 
+    _sleeping = false;
+    _threadSafe = false;
+    _threadSafeDirty = true;
+    _sharePose = false;
+    _poseOverridden = false;
+    _culled = false;
+    _wasCulled = false;
+    _boundsDirty = true;
+    _boundsBakePending = false;
+    _bounds.clear();
     _delayDispose = false;
     _lockDispose = false;
     _lockActionAndEvent = false;
     _slotsDirty = false;
+    _eventMaskDirty = true;
+    _eventMask = 0;
 
     for (const auto bone : _bones)
     {
@@ -68,6 +123,7 @@ void Armature::_onClear()
     _bones.clear();
     _slots.clear();
     _events.clear();
+    _poseFollowers.clear();
 }
 
 void Armature::_sortBones()
@@ -132,6 +188,7 @@ void Armature::_addBoneToBoneList(Bone* value)
     {
         _bonesDirty = true;
         _bones.push_back(value);
+        wakeUp();
         _animation->_timelineStateDirty = true;
     }
 }
@@ -143,6 +200,7 @@ void Armature::_removeBoneFromBoneList(Bone* value)
     {
         _bones.erase(iterator);
         _animation->_timelineStateDirty = true;
+        wakeUp();
     }
 }
 
@@ -152,6 +210,8 @@ void Armature::_addSlotToSlotList(Slot* value)
     {
         _slotsDirty = true;
         _slots.push_back(value);
+        _invalidThreadSafe();
+        wakeUp();
         _animation->_timelineStateDirty = true;
     }
 }
@@ -162,17 +222,36 @@ void Armature::_removeSlotFromSlotList(Slot* value)
     if (iterator != _slots.end())
     {
         _slots.erase(iterator);
+        _invalidThreadSafe();
         _animation->_timelineStateDirty = true;
+        wakeUp();
     }
 }
 
-void Armature::_bufferEvent(EventObject* value, const std::string& type)
+void Armature::_bufferEvent(EventObject* value, EventObjectType type)
 {
     value->type = type;
     value->armature = this;
     _events.push_back(value);
 }
 
+bool Armature::_hasEvent(EventObjectType type)
+{
+    if (_eventMaskDirty)
+    {
+        _eventMaskDirty = false;
+        _eventMask = _display ? _display->getEventMask() : 0;
+    }
+
+    return (_eventMask & (1u << (unsigned)type)) != 0;
+}
+
+void Armature::_bufferAction(ActionData* value)
+{
+    _action = value;
+    wakeUp();
+}
+
 void Armature::dispose()
 {
     _delayDispose = true;
@@ -183,12 +262,155 @@ void Armature::dispose()
     }
 }
 
+bool Armature::_isCulled() const
+{
+    return _culled || (_parent && _parent->_armature && _parent->_armature->_isCulled());
+}
+
+bool Armature::_isThreadSafe()
+{
+    if (_threadSafeDirty)
+    {
+        _threadSafeDirty = false;
+        _threadSafe = true;
+
+        for (const auto slot : _slots)
+        {
+            const auto childArmature = slot->getChildArmature();
+            if (!slot->_isThreadSafe() || (childArmature && !childArmature->_isThreadSafe()))
+            {
+                _threadSafe = false;
+                break;
+            }
+        }
+    }
+
+    return _threadSafe;
+}
+
+void Armature::_invalidThreadSafe()
+{
+    // Parents cache the result of their child armatures.
+    for (auto armature = this; armature; armature = armature->_parent ? armature->_parent->getArmature() : nullptr)
+    {
+        armature->_threadSafeDirty = true;
+    }
+}
+
+bool Armature::_canSleep() const
+{
+    if (!_events.empty() || _action || _poseSource || _delayAdvanceTime >= 0.f || _isCulled() || !_animation->_canSleep())
+    {
+        return false;
+    }
+
+    for (const auto slot : _slots)
+    {
+        const auto childArmature = slot->getChildArmature();
+        if (childArmature && !childArmature->_sleeping)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Armature::_setPoseSource(Armature* value)
+{
+    if (_poseSource == value)
+    {
+        return;
+    }
+
+    if (_poseSource)
+    {
+        auto& followers = _poseSource->_poseFollowers;
+        followers.erase(std::find(followers.begin(), followers.end(), this));
+    }
+
+    _poseSource = value;
+
+    if (_poseSource)
+    {
+        _poseSource->_poseFollowers.push_back(this);
+    }
+}
+
+bool Armature::_followPose(AnimationData& animationData, std::size_t cacheFrameIndex)
+{
+    // Followers skip their slot updates, only slots without display nodes of their own, as batch slots, show the shared pose.
+    if (
+        !Armature::_sharedPoseTick || _parent || _poseOverridden ||
+        animationData.hasBoneTimelineEvent || animationData.hasSlotTimelineEvent ||
+        cacheFrameIndex >= animationData.sharedPoses.size() || !_isThreadSafe()
+    )
+    {
+        return false;
+    }
+
+    // Child armatures advance with their own animations, their poses can not be shared.
+    for (const auto slot : _slots)
+    {
+        if (slot->getChildArmature())
+        {
+            return false;
+        }
+    }
+
+    const auto leader = animationData.sharedPoses[cacheFrameIndex];
+    if (
+        leader && leader != this && animationData.sharedPoseTicks[cacheFrameIndex] == Armature::_sharedPoseTick &&
+        leader->_armatureData == _armatureData && leader->_skinData == _skinData
+    )
+    {
+        _setPoseSource(leader);
+        return true;
+    }
+
+    _sharePose = true;
+    return false;
+}
+
+void Armature::_bakeBounds()
+{
+    if (!_boundsBakePending)
+    {
+        return;
+    }
+
+    _boundsBakePending = false;
+
+    if (!_poseOverridden && !_cacheAnimationData->getCachedBounds(_skinData, _cacheFrameIndex))
+    {
+        _cacheAnimationData->cacheBounds(_skinData, _cacheFrameIndex, getBounds());
+    }
+}
+
+void Armature::_publishPoseSnapshot()
+{
+    if (_poseSnapshots)
+    {
+        _poseSnapshots->_publish(*this);
+    }
+}
+
 void Armature::advanceTime(float passedTime)
 {
+    if (_sleeping)
+    {
+        return;
+    }
+
     _lockDispose = true;
 
     const auto scaledPassedTime = passedTime * _animation->timeScale;
+    const auto isCulled = _isCulled();
 
+    _cacheAnimationData = nullptr;
+    _sharePose = false;
+    _eventMaskDirty = true;
+    _setPoseSource(nullptr);
     //
     _animation->_advanceTime(scaledPassedTime);
 
@@ -206,14 +428,57 @@ void Armature::advanceTime(float passedTime)
     }
 
     //
-    for (const auto bone : _bones)
+    if (_poseSource)
     {
-        bone->_update(_cacheFrameIndex);
+        // The pose of this tick lives in the pose source, a later update rebuilds it from scratch.
+        _wasCulled = true;
+    }
+    else if (!isCulled)
+    {
+        if (_wasCulled)
+        {
+            _wasCulled = false;
+
+            // Not invalidUpdate(), which marks the pose as overridden.
+            for (const auto bone : _bones)
+            {
+                bone->_transformDirty = Bone::BoneTransformDirty::All;
+            }
+        }
+
+        for (const auto bone : _bones)
+        {
+            bone->_update(_cacheFrameIndex);
+        }
+
+        _boundsDirty = true;
+    }
+    else
+    {
+        _wasCulled = true;
+
+        // Timelines with events still run, their blended results are dropped.
+        for (const auto bone : _bones)
+        {
+            bone->_blendIndex = 0;
+        }
     }
 
     for (const auto slot : _slots)
     {
-        slot->_update(_cacheFrameIndex);
+        if (_poseSource)
+        {
+            continue;
+        }
+
+        if (isCulled)
+        {
+            slot->_blendIndex = 0;
+        }
+        else
+        {
+            slot->_update(_cacheFrameIndex);
+        }
 
         const auto childArmature = slot->getChildArmature();
         if (childArmature)
@@ -229,6 +494,57 @@ void Armature::advanceTime(float passedTime)
         }
     }
 
+    // Followers bake nothing, their pose source does.
+    _boundsBakePending =
+        !isCulled && !_poseSource && !_poseOverridden && _cacheAnimationData && _cacheFrameIndex >= 0 &&
+        !_cacheAnimationData->getCachedBounds(_skinData, _cacheFrameIndex);
+
+    if (_sharePose && !isCulled && _cacheAnimationData && _cacheFrameIndex >= 0)
+    {
+        _cacheAnimationData->sharedPoses[_cacheFrameIndex] = this;
+        _cacheAnimationData->sharedPoseTicks[_cacheFrameIndex] = Armature::_sharedPoseTick;
+    }
+
+    if (_boundsBakePending || _poseSnapshots)
+    {
+        if (Armature::meshDeformer)
+        {
+            // Skinned vertices and bounds are not ready before MeshDeformer::deform().
+            Armature::meshDeformer->_addArmature(this);
+        }
+        else
+        {
+            _bakeBounds();
+            _publishPoseSnapshot();
+        }
+    }
+
+    if (Armature::_deferActionAndEvent)
+    {
+        return;
+    }
+
+    _dispatchActionAndEvent();
+}
+
+void Armature::_flushActionAndEvent()
+{
+    for (const auto slot : _slots)
+    {
+        const auto childArmature = slot->getChildArmature();
+        if (childArmature)
+        {
+            childArmature->_flushActionAndEvent();
+        }
+    }
+
+    _dispatchActionAndEvent();
+}
+
+void Armature::_dispatchActionAndEvent()
+{
+    _lockDispose = true;
+
     if (!_lockActionAndEvent)
     {
         _lockActionAndEvent = true;
@@ -237,7 +553,7 @@ void Armature::advanceTime(float passedTime)
         {
             for (const auto event : _events)
             {
-                if (Armature::soundEventManager && event->type == EventObject::SOUND_EVENT)
+                if (Armature::soundEventManager && event->type == EventObjectType::Sound)
                 {
                     Armature::soundEventManager->_dispatchEvent(event);
                 }
@@ -250,6 +566,9 @@ void Armature::advanceTime(float passedTime)
             }
 
             _events.clear();
+
+            // Listeners may have changed in the callbacks.
+            _eventMaskDirty = true;
         }
 
         if (_action)
@@ -291,6 +610,7 @@ void Armature::advanceTime(float passedTime)
         _lockActionAndEvent = false;
     }
 
+    _sleeping = _canSleep();
     _lockDispose = false;
 
     if (_delayDispose)
@@ -305,8 +625,46 @@ void Armature::advanceTime(float passedTime)
     }
 }
 
+void Armature::wakeUp()
+{
+    // A parent stops advancing its child armatures while it sleeps.
+    for (auto armature = this; armature && armature->_sleeping; armature = armature->_parent ? armature->_parent->getArmature() : nullptr)
+    {
+        armature->_sleeping = false;
+
+        if (armature->_clock)
+        {
+            armature->_clock->_wakeUp(armature);
+        }
+    }
+}
+
+void Armature::setPoseSnapshotEnabled(bool value)
+{
+    if (value == (_poseSnapshots != nullptr))
+    {
+        return;
+    }
+
+    if (value)
+    {
+        // Sleeping armatures do not publish, the reader starts with the current pose.
+        _poseSnapshots = new PoseSnapshotBuffer();
+        _publishPoseSnapshot();
+    }
+    else
+    {
+        // A pending MeshDeformer::deform() still bakes the bounds and publishes nothing.
+        delete _poseSnapshots;
+        _poseSnapshots = nullptr;
+    }
+}
+
 void Armature::invalidUpdate(const std::string& boneName, bool updateSlotDisplay)
 {
+    _poseOverridden = true;
+    wakeUp();
+
     if (boneName.empty())
     {
         for (const auto bone: _bones)
@@ -343,6 +701,66 @@ void Armature::invalidUpdate(const std::string& boneName, bool updateSlotDisplay
     }
 }
 
+const Rectangle& Armature::getBounds()
+{
+    if (_poseSource)
+    {
+        return _poseSource->getBounds();
+    }
+
+    if (!_poseOverridden && _cacheAnimationData && _cacheFrameIndex >= 0)
+    {
+        const auto cachedBounds = _cacheAnimationData->getCachedBounds(_skinData, _cacheFrameIndex);
+        if (cachedBounds)
+        {
+            return *cachedBounds;
+        }
+    }
+
+    if (_boundsDirty)
+    {
+        _boundsDirty = false;
+
+        auto isEmpty = true;
+        Rectangle slotBounds;
+        for (const auto slot : _slots)
+        {
+            if (!slot->_getDisplayBounds(slotBounds))
+            {
+                continue;
+            }
+
+            if (isEmpty)
+            {
+                isEmpty = false;
+                _bounds = slotBounds; // copy
+            }
+            else
+            {
+                const auto right = std::max(_bounds.x + _bounds.width, slotBounds.x + slotBounds.width);
+                const auto bottom = std::max(_bounds.y + _bounds.height, slotBounds.y + slotBounds.height);
+                _bounds.x = std::min(_bounds.x, slotBounds.x);
+                _bounds.y = std::min(_bounds.y, slotBounds.y);
+                _bounds.width = right - _bounds.x;
+                _bounds.height = bottom - _bounds.y;
+            }
+        }
+
+        if (isEmpty)
+        {
+            _bounds.clear();
+        }
+    }
+
+    return _bounds;
+}
+
+const Rectangle* Armature::getClipBounds(const std::string& animationName) const
+{
+    const auto animationData = _armatureData ? _armatureData->getAnimation(animationName) : nullptr;
+    return animationData ? animationData->getClipBounds(_skinData) : nullptr;
+}
+
 Slot* Armature::getSlot(const std::string& name) const
 {
     for (const auto slot : _slots)
@@ -448,6 +866,9 @@ void Armature::removeBone(Bone* value)
 void Armature::setReplaceTexture(void* texture)
 {
     _replaceTexture = texture;
+    _poseOverridden = true;
+    wakeUp();
+
     for (auto const slot : _slots) 
     {
         slot->invalidUpdate();
@@ -459,6 +880,7 @@ void Armature::setCacheFrameRate(unsigned value)
     if (_armatureData->cacheFrameRate != value)
     {
         _armatureData->cacheFrames(value);
+        wakeUp();
     }
 }
 
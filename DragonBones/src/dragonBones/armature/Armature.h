@@ -2,6 +2,7 @@
 #define DRAGONBONES_ARMATURE_H
 
 #include "../core/BaseObject.h"
+#include "../geom/Rectangle.h"
 #include "../model/ArmatureData.h"
 #include "../animation/IAnimateble.h"
 #include "../events/EventObject.h"
@@ -12,6 +13,9 @@ DRAGONBONES_NAMESPACE_BEGIN
 class Bone;
 class Slot;
 class Animation;
+class MeshDeformer;
+class PoseSnapshotBuffer;
+class WorldClock;
 
 class Armature : public BaseObject, public IAnimateble
 {
@@ -19,6 +23,12 @@ class Armature : public BaseObject, public IAnimateble
 
 public:
     static IEventDispatcher* soundEventManager;
+    /** When set, mesh slots are deformed by MeshDeformer::deform() instead of during advanceTime. */
+    static MeshDeformer* meshDeformer;
+    /** @private Per thread, set by WorldClock on its worker threads, events and actions wait for _flushActionAndEvent(). */
+    static thread_local bool _deferActionAndEvent;
+    /** @private Per thread, set by WorldClock::poseSharing for the tick the thread advances, 0 disables pose sharing. */
+    static thread_local unsigned _sharedPoseTick;
 
 public:
     void* userData;
@@ -29,6 +39,8 @@ public: // private
     /** @private */
     int _cacheFrameIndex;
     /** @private */
+    AnimationData* _cacheAnimationData;
+    /** @private */
     float _delayAdvanceTime;
     /** @private */
     ArmatureData* _armatureData;
@@ -44,15 +56,37 @@ public: // private
     Slot* _parent;
     /** @private */
     ActionData* _action;
+    /** @private */
+    Armature* _poseSource;
+    /** @private Bakes the bounds and publishes the snapshots of this armature once its skinned meshes are deformed. */
+    MeshDeformer* _meshDeformer;
+    /** @private Index in the armatures of _meshDeformer. */
+    std::size_t _meshDeformerIndex;
+    /** @private Clock the armature was last added to, told when the armature wakes up. */
+    WorldClock* _clock;
 
 protected:
+    bool _sleeping;
+    bool _threadSafe;
+    bool _threadSafeDirty;
+    bool _sharePose;
+    bool _poseOverridden;
+    bool _culled;
+    bool _wasCulled;
+    bool _boundsDirty;
+    bool _boundsBakePending;
+    Rectangle _bounds;
     bool _delayDispose;
     bool _lockDispose;
     bool _lockActionAndEvent;
     bool _slotsDirty;
+    bool _eventMaskDirty;
+    unsigned _eventMask;
     std::vector<Bone*> _bones;
     std::vector<Slot*> _slots;
     std::vector<EventObject*> _events;
+    std::vector<Armature*> _poseFollowers;
+    PoseSnapshotBuffer* _poseSnapshots;
 
 public:
     /** @private */
@@ -67,6 +101,9 @@ protected:
     void _onClear() override;
     void _sortBones();
     void _sortSlots();
+    void _dispatchActionAndEvent();
+    bool _canSleep() const;
+    void _setPoseSource(Armature* value);
 
 public:
     /** @private */
@@ -78,7 +115,25 @@ public:
     /** @private */
     void _removeSlotFromSlotList(Slot* value);
     /** @private */
-    void _bufferEvent(EventObject* value, const std::string& type);
+    void _bufferEvent(EventObject* value, EventObjectType type);
+    /** @private Whether the display listens to type, its event mask is queried once per advanceTime(). */
+    bool _hasEvent(EventObjectType type);
+    /** @private */
+    void _bufferAction(ActionData* value);
+    /** @private */
+    bool _isCulled() const;
+    /** @private Whether every slot, child armatures included, is thread safe. Cached until a slot or child armature changes. */
+    bool _isThreadSafe();
+    /** @private */
+    void _invalidThreadSafe();
+    /** @private */
+    void _flushActionAndEvent();
+    /** @private */
+    bool _followPose(AnimationData& animationData, std::size_t cacheFrameIndex);
+    /** @private Caches the bounds of this update for the cache frame and skin, unless the pose is overridden. */
+    void _bakeBounds();
+    /** @private */
+    void _publishPoseSnapshot();
 
 public:
     void dispose();
@@ -130,6 +185,71 @@ public:
         return *_animation;
     }
 
+    /** Culled armatures only advance animation time and dispatch events, the pose catches up once they are not culled. */
+    inline bool getCulled() const
+    {
+        return _culled;
+    }
+    inline void setCulled(bool value)
+    {
+        if (_culled != value)
+        {
+            _culled = value;
+            wakeUp();
+        }
+    }
+
+    /** Sleeping armatures skip advanceTime, they fall asleep once their animation is stopped or completed and every child armature sleeps. */
+    inline bool getSleeping() const
+    {
+        return _sleeping;
+    }
+    /** Play, fade, display, texture, hierarchy changes and invalidUpdate() wake the armature, call it after changing AnimationState::weight directly. */
+    void wakeUp();
+
+    /**
+     * Armature whose bones and slots hold the pose of the current tick, itself unless the pose was shared by another armature.
+     * See WorldClock::poseSharing, batch renderers draw the slots of the pose source.
+     * The bones and slots of a follower keep their last own pose, query getPoseSource()->getBone() for the shared one. getBounds() is redirected.
+     */
+    inline const Armature* getPoseSource() const
+    {
+        return _poseSource ? _poseSource : this;
+    }
+
+    /**
+     * Set by per instance changes pose sharing can not see: Slot::setDisplayIndex(), setDisplayList(), setDisplay(), setColor() and invalidUpdate(),
+     * Bone::invalidUpdate() (after changing offset or ikWeight), invalidUpdate() and setReplaceTexture().
+     * An overridden armature neither leads nor follows a shared pose, clear it after restoring the defaults to share poses again.
+     */
+    inline bool getPoseOverridden() const
+    {
+        return _poseOverridden;
+    }
+    inline void setPoseOverridden(bool value)
+    {
+        _poseOverridden = value;
+    }
+
+    /**
+     * Snapshots of the slots published after every advanceTime(), or after MeshDeformer::deform() while Armature::meshDeformer is set,
+     * for a render thread to draw the last completed pose while the next one is computed. nullptr unless enabled.
+     * The buffer is deleted when snapshots are disabled or the armature is disposed, the render thread must not use it by then.
+     */
+    inline PoseSnapshotBuffer* getPoseSnapshots() const
+    {
+        return _poseSnapshots;
+    }
+    void setPoseSnapshotEnabled(bool value);
+
+    /**
+     * Bounds of all slot displays in armature space, baked per cache frame and skin when a cache frame rate is set and the pose is not overridden,
+     * otherwise as of the last update that was not culled. While Armature::meshDeformer is set skinned meshes count once MeshDeformer::deform() ran.
+     */
+    const Rectangle& getBounds();
+    /** Union of the baked bounds of an animation for the skin of this armature, nullptr until every cache frame of the animation was played with that skin. */
+    const Rectangle* getClipBounds(const std::string& animationName) const;
+
     inline unsigned getCacheFrameRate()
     {
         return _armatureData->cacheFrameRate;
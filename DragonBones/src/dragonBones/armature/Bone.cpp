@@ -262,6 +262,18 @@ void Bone::_setIK(Bone* value, unsigned chain, unsigned chainIndex)
     if (this->_armature)
     {
         this->_armature->_bonesDirty = true;
+        this->_armature->wakeUp();
+    }
+}
+
+void Bone::invalidUpdate()
+{
+    _transformDirty = BoneTransformDirty::All;
+
+    if (this->_armature)
+    {
+        this->_armature->setPoseOverridden(true);
+        this->_armature->wakeUp();
     }
 }
 
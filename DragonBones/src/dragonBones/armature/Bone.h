@@ -60,11 +60,7 @@ public:
 public:
     bool contains(const TransformObject* child) const;
     void setVisible(bool value);
-
-    inline void invalidUpdate()
-    {
-        _transformDirty = BoneTransformDirty::All;
-    }
+    void invalidUpdate();
 
     inline const std::vector<Bone*>& getBones() const
     {
@@ -0,0 +1,161 @@
+#include "Crowd.h"
+#include "Armature.h"
+#include "MeshDeformer.h"
+#include "../animation/Animation.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+Crowd::Crowd() :
+    instances(),
+    _frameBatchStarts(),
+    _batches(),
+    _vertices(),
+    _indices(),
+    _frameRate(0.f),
+    _clipNames(),
+    _clipDurations(),
+    _clipPlayTimes(),
+    _clipFrameStarts(),
+    _clipFrameCounts()
+{
+}
+Crowd::~Crowd()
+{
+    clear();
+}
+
+int Crowd::_getFrameIndex(const CrowdInstance& instance) const
+{
+    if (instance.clip >= _clipNames.size())
+    {
+        return -1;
+    }
+
+    // Clips with play times keep the time of all plays, the last one ends on the last frame.
+    const auto duration = _clipDurations[instance.clip];
+    const auto playTimes = _clipPlayTimes[instance.clip];
+    auto time = instance.time;
+    if (duration > 0.f && time > duration)
+    {
+        time = (playTimes > 0 && time >= duration * playTimes) ? duration : std::fmod(time, duration);
+    }
+
+    const auto frameCount = _clipFrameCounts[instance.clip];
+    auto frame = (std::size_t)std::max(time * _frameRate, 0.f);
+    if (frame >= frameCount)
+    {
+        frame = frameCount - 1;
+    }
+
+    return (int)(_clipFrameStarts[instance.clip] + frame);
+}
+
+void Crowd::bake(Armature& armature, unsigned frameRate)
+{
+    clear();
+
+    if (frameRate == 0)
+    {
+        frameRate = armature.getCacheFrameRate() > 0 ? armature.getCacheFrameRate() : armature.getArmatureData().frameRate;
+    }
+
+    _frameRate = (float)frameRate;
+    _frameBatchStarts.push_back(0);
+
+    static const Matrix identityMatrix;
+    RenderBatchBuilder batchBuilder;
+    auto& animation = armature.getAnimation();
+
+    for (const auto& pair : armature.getArmatureData().animations)
+    {
+        const auto animationData = pair.second;
+        const auto frameCount = (std::size_t)std::max(std::floor(animationData->duration * _frameRate), 1.f);
+
+        _clipNames.push_back(pair.first);
+        _clipDurations.push_back(animationData->duration);
+        _clipPlayTimes.push_back(animationData->playTimes);
+        _clipFrameStarts.push_back(_frameBatchStarts.size() - 1);
+        _clipFrameCounts.push_back(frameCount);
+
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            // Sampled mid frame, a stopped state holds its time while the advance completes its fade in.
+            animation.gotoAndStopByTime(pair.first, (i + 0.5f) / _frameRate);
+            armature.advanceTime(1.f / _frameRate);
+
+            if (Armature::meshDeformer)
+            {
+                Armature::meshDeformer->deform();
+            }
+
+            batchBuilder.clear();
+            batchBuilder.addArmature(armature, identityMatrix);
+
+            const auto vertexOffset = (unsigned)_vertices.size();
+            const auto indexOffset = (unsigned)_indices.size();
+            for (const auto& batch : batchBuilder.batches)
+            {
+                _batches.push_back(batch); // copy
+
+                auto& bakedBatch = _batches.back();
+                bakedBatch.armature = nullptr;
+                bakedBatch.vertexStart += vertexOffset;
+                bakedBatch.indexStart += indexOffset;
+            }
+
+            _vertices.insert(_vertices.end(), batchBuilder.vertices.cbegin(), batchBuilder.vertices.cend());
+            _indices.insert(_indices.end(), batchBuilder.indices.cbegin(), batchBuilder.indices.cend());
+            _frameBatchStarts.push_back(_batches.size());
+        }
+    }
+}
+
+void Crowd::clear()
+{
+    _frameBatchStarts.clear();
+    _batches.clear();
+    _vertices.clear();
+    _indices.clear();
+
+    _frameRate = 0.f;
+    _clipNames.clear();
+    _clipDurations.clear();
+    _clipPlayTimes.clear();
+    _clipFrameStarts.clear();
+    _clipFrameCounts.clear();
+}
+
+void Crowd::advanceTime(float passedTime)
+{
+    for (auto& instance : instances)
+    {
+        if (instance.clip >= _clipDurations.size())
+        {
+            continue;
+        }
+
+        const auto duration = _clipDurations[instance.clip];
+        instance.time += passedTime * instance.speed;
+
+        if (_clipPlayTimes[instance.clip] > 0)
+        {
+            instance.time = std::min(std::max(instance.time, 0.f), duration * _clipPlayTimes[instance.clip]);
+        }
+        else if (duration > 0.f)
+        {
+            instance.time = std::fmod(instance.time, duration);
+            if (instance.time < 0.f)
+            {
+                instance.time += duration;
+            }
+        }
+    }
+}
+
+int Crowd::getClipIndex(const std::string& name) const
+{
+    const auto iterator = std::find(_clipNames.cbegin(), _clipNames.cend(), name);
+    return iterator != _clipNames.cend() ? (int)(iterator - _clipNames.cbegin()) : -1;
+}
+
+DRAGONBONES_NAMESPACE_END
@@ -0,0 +1,112 @@
+#ifndef DRAGONBONES_CROWD_H
+#define DRAGONBONES_CROWD_H
+
+#include "RenderBatchBuilder.h"
+#include "../animation/IAnimateble.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+class Armature;
+
+/**
+ * Crowd member, the pose is sampled from the frames baked by Crowd::bake().
+ */
+class CrowdInstance final
+{
+public:
+    /** Index into Crowd::getClipNames(). */
+    unsigned clip;
+    /** Seconds since the clip started, looping clips wrap it, clips with play times count every play and stop at the end of the last. */
+    float time;
+    float speed;
+    /** Armature space to crowd space. */
+    Matrix transform;
+    /** Tint, multiplied with the baked slot colors. */
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+
+    CrowdInstance():
+        clip(0),
+        time(0.f),
+        speed(1.f),
+        transform(),
+        r(255),
+        g(255),
+        b(255),
+        a(255)
+    {
+    }
+    ~CrowdInstance() {}
+};
+
+/**
+ * Many copies of one armature without bones, slots or animation states, drawn by RenderBatchBuilder::addCrowd().
+ * Every clip is baked once to render vertices per frame, all instances share them.
+ */
+class Crowd final : public IAnimateble
+{
+public:
+    std::vector<CrowdInstance> instances;
+
+public: // private
+    /** @private */
+    std::vector<std::size_t> _frameBatchStarts;
+    /** @private Batches of all baked frames, vertexStart and indexStart refer to _vertices and _indices. */
+    std::vector<RenderBatch> _batches;
+    /** @private */
+    std::vector<RenderVertex> _vertices;
+    /** @private */
+    std::vector<unsigned short> _indices;
+
+private:
+    float _frameRate;
+    std::vector<std::string> _clipNames;
+    std::vector<float> _clipDurations;
+    std::vector<unsigned> _clipPlayTimes;
+    std::vector<std::size_t> _clipFrameStarts;
+    std::vector<std::size_t> _clipFrameCounts;
+
+public:
+    Crowd();
+    ~Crowd();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(Crowd);
+
+public:
+    /** @private Baked frame of the instance, -1 if its clip was not baked. */
+    int _getFrameIndex(const CrowdInstance& instance) const;
+
+public:
+    /**
+     * Poses armature at every frame of each of its animations and keeps what RenderBatchBuilder emits for it.
+     * frameRate 0 uses the cache frame rate of the armature or else the frame rate of its data.
+     * Child armatures advance one frame per baked frame. Events are dispatched by armature, it is left stopped at the last baked frame.
+     */
+    void bake(Armature& armature, unsigned frameRate = 0);
+    void clear();
+    /** Advances every instance by its speed, clips with play times hold their last frame once played that many times, the others loop. */
+    void advanceTime(float passedTime) override;
+    /** Index for CrowdInstance::clip, -1 if no clip of that name was baked. */
+    int getClipIndex(const std::string& name) const;
+
+    inline const std::vector<std::string>& getClipNames() const
+    {
+        return _clipNames;
+    }
+
+    inline float getClipDuration(unsigned clip) const
+    {
+        return _clipDurations[clip];
+    }
+
+    inline float getFrameRate() const
+    {
+        return _frameRate;
+    }
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_CROWD_H
@@ -0,0 +1,129 @@
+#include "DrawableSlotVisitor.h"
+#include "Armature.h"
+#include "Slot.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+DrawableSlotVisitor::DrawableSlotVisitor() :
+    _sortedSlots()
+{
+}
+DrawableSlotVisitor::~DrawableSlotVisitor()
+{
+    clear();
+}
+
+void DrawableSlotVisitor::_visitArmature(const Armature& armature, const Matrix* parentMatrix, unsigned depth, const Visit& visit)
+{
+    if (_sortedSlots.size() <= depth)
+    {
+        _sortedSlots.resize(depth + 1);
+    }
+
+    auto& slots = _sortedSlots[depth];
+    slots.assign(armature.getSlots().cbegin(), armature.getSlots().cend());
+    std::stable_sort(slots.begin(), slots.end(), [](const Slot* a, const Slot* b)
+    {
+        return a->_displayDataSet->slot->zOrder < b->_displayDataSet->slot->zOrder;
+    });
+
+    Matrix matrix;
+    DrawableSlot drawableSlot;
+
+    // Child armatures may grow _sortedSlots, so slots are fetched by index.
+    for (std::size_t i = 0, l = slots.size(); i < l; ++i)
+    {
+        const auto slot = _sortedSlots[depth][i];
+        if (!slot->getDisplay() || slot->getDisplayIndex() < 0 || (slot->getParent() && !slot->getParent()->getVisible()))
+        {
+            continue;
+        }
+
+        const auto childArmature = slot->getChildArmature();
+        if (childArmature)
+        {
+            matrix = *slot->globalTransformMatrix; // copy
+            if (parentMatrix)
+            {
+                matrix.concat(*parentMatrix);
+            }
+
+            _visitArmature(*childArmature->getPoseSource(), &matrix, depth + 1, visit);
+            continue;
+        }
+
+        DisplayData* rawDisplayData = nullptr;
+        const auto currentDisplayData = slot->_getCurrentDisplayData(&rawDisplayData);
+        if (!currentDisplayData || !currentDisplayData->textureData)
+        {
+            continue;
+        }
+
+        const auto isMesh = slot->_meshData && slot->getDisplay() == slot->getMeshDisplay();
+        auto& transform = drawableSlot.transform;
+
+        drawableSlot.slot = slot;
+        drawableSlot.displayData = currentDisplayData;
+        drawableSlot.meshData = isMesh ? slot->_meshData : nullptr;
+        drawableSlot.vertices = nullptr;
+        drawableSlot.vertexCount = 0;
+        drawableSlot.ffdVertices = nullptr;
+
+        // Skinned vertices are already in armature space.
+        if (isMesh && slot->_meshData->skinned)
+        {
+            transform.identity();
+        }
+        else
+        {
+            transform = *slot->globalTransformMatrix; // copy
+        }
+
+        if (parentMatrix)
+        {
+            transform.concat(*parentMatrix);
+        }
+
+        if (isMesh)
+        {
+            const auto& meshData = *slot->_meshData;
+            const auto& meshVertices = meshData.skinned ? slot->_skinnedVertices : meshData.vertices;
+            const auto vertexCount = meshData.uvs.size() / 2;
+            if (meshVertices.size() < vertexCount * 2)
+            {
+                continue;
+            }
+
+            drawableSlot.vertices = meshVertices.data();
+            drawableSlot.vertexCount = (unsigned)vertexCount;
+
+            // Unskinned FFD offsets cover every vertex, skinned ones are already in _skinnedVertices.
+            if (!meshData.skinned && !slot->_ffdVertices.empty())
+            {
+                drawableSlot.ffdVertices = slot->_ffdVertices.data();
+            }
+        }
+        else
+        {
+            Rectangle rect;
+            slot->_getImageRect(*currentDisplayData, rawDisplayData, rect);
+
+            transform.tx += transform.a * rect.x + transform.c * rect.y;
+            transform.ty += transform.b * rect.x + transform.d * rect.y;
+        }
+
+        visit(drawableSlot);
+    }
+}
+
+void DrawableSlotVisitor::visitArmature(const Armature& armature, const Visit& visit)
+{
+    _visitArmature(*armature.getPoseSource(), nullptr, 0, visit);
+}
+
+void DrawableSlotVisitor::clear()
+{
+    _sortedSlots.clear();
+}
+
+DRAGONBONES_NAMESPACE_END
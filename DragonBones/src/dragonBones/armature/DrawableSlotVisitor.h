@@ -0,0 +1,62 @@
+#ifndef DRAGONBONES_DRAWABLE_SLOT_VISITOR_H
+#define DRAGONBONES_DRAWABLE_SLOT_VISITOR_H
+
+#include "../core/DragonBones.h"
+#include "../geom/Matrix.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+class Armature;
+class Slot;
+class DisplayData;
+class MeshData;
+
+/**
+ * Slot with a texture to draw, as DrawableSlotVisitor passes it.
+ */
+class DrawableSlot final
+{
+public:
+    const Slot* slot;
+    /** Current display data, its textureData is never nullptr. */
+    const DisplayData* displayData;
+    /** nullptr for images. */
+    const MeshData* meshData;
+    /** Texture region (images) or vertices (meshes) to the space of the visited armature. */
+    Matrix transform;
+    /** Mesh vertices as x, y pairs, skinned ones already deformed, nullptr and 0 for images. */
+    const float* vertices;
+    unsigned vertexCount;
+    /** Offsets to add to vertices, nullptr if the mesh has none. */
+    const float* ffdVertices;
+};
+
+/**
+ * Walks the drawable slots of an armature in draw order, flattening child armatures into their parents.
+ * Shared by RenderBatchBuilder and PoseSnapshot so both draw the same slots the same way.
+ */
+class DrawableSlotVisitor final
+{
+public:
+    typedef std::function<void(const DrawableSlot& drawableSlot)> Visit;
+
+private:
+    std::vector<std::vector<Slot*>> _sortedSlots;
+
+public:
+    DrawableSlotVisitor();
+    ~DrawableSlotVisitor();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(DrawableSlotVisitor);
+
+    void _visitArmature(const Armature& armature, const Matrix* parentMatrix, unsigned depth, const Visit& visit);
+
+public:
+    /** Calls visit for each drawable slot of the pose source of armature and of its child armatures, in draw order. */
+    void visitArmature(const Armature& armature, const Visit& visit);
+    void clear();
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_DRAWABLE_SLOT_VISITOR_H
@@ -0,0 +1,149 @@
+#include "MeshDeformer.h"
+#include "Slot.h"
+#include "Armature.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+MeshDeformer::MeshDeformer(unsigned threadCount) :
+    _slots(),
+    _skinnedSlots(),
+    _armatures(),
+    _workerPool(threadCount),
+    _mutex()
+{
+}
+MeshDeformer::~MeshDeformer()
+{
+    clear();
+}
+
+void MeshDeformer::_addSlot(Slot* value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (value && !value->_meshDeformer)
+    {
+        value->_meshDeformer = this;
+        value->_meshDeformerIndex = _slots.size();
+        _slots.push_back(value);
+    }
+}
+
+void MeshDeformer::_removeSlot(Slot* value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (value && value->_meshDeformer == this)
+    {
+        // Left as a hole deform() skips, erasing would make disposing many slots quadratic.
+        _slots[value->_meshDeformerIndex] = nullptr;
+        value->_meshDeformer = nullptr;
+    }
+}
+
+void MeshDeformer::_addArmature(Armature* value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (value && !value->_meshDeformer)
+    {
+        value->_meshDeformer = this;
+        value->_meshDeformerIndex = _armatures.size();
+        _armatures.push_back(value);
+    }
+}
+
+void MeshDeformer::_removeArmature(Armature* value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (value && value->_meshDeformer == this)
+    {
+        _armatures[value->_meshDeformerIndex] = nullptr;
+        value->_meshDeformer = nullptr;
+    }
+}
+
+void MeshDeformer::deform()
+{
+    for (const auto slot : _slots)
+    {
+        if (slot && slot->_meshData && slot->_meshData->skinned)
+        {
+            _skinnedSlots.push_back(slot);
+        }
+    }
+
+    // Skinning only reads bone matrices and writes slot owned buffers.
+    _workerPool.parallelFor(_skinnedSlots.size(), [this](std::size_t index) 
+    {
+        const auto slot = _skinnedSlots[index];
+        slot->_skinMesh(slot->_skinnedVertices, slot->_skinnedBounds);
+    });
+
+    // Display updates stay on the calling thread.
+    for (const auto slot : _slots)
+    {
+        if (!slot)
+        {
+            continue;
+        }
+
+        slot->_meshDeformer = nullptr;
+
+        if (slot->_meshData)
+        {
+            slot->_updateMesh();
+        }
+    }
+
+    _slots.clear();
+    _skinnedSlots.clear();
+
+    // Armatures of the same data share the baked bounds, they bake on the calling thread.
+    for (const auto armature : _armatures)
+    {
+        if (armature)
+        {
+            armature->_meshDeformer = nullptr;
+            armature->_bakeBounds();
+        }
+    }
+
+    // Each armature only writes its own snapshots.
+    _workerPool.parallelFor(_armatures.size(), [this](std::size_t index)
+    {
+        const auto armature = _armatures[index];
+        if (armature)
+        {
+            armature->_publishPoseSnapshot();
+        }
+    });
+
+    _armatures.clear();
+}
+
+void MeshDeformer::clear()
+{
+    for (const auto slot : _slots)
+    {
+        if (slot)
+        {
+            slot->_meshDeformer = nullptr;
+        }
+    }
+
+    for (const auto armature : _armatures)
+    {
+        if (armature)
+        {
+            armature->_meshDeformer = nullptr;
+        }
+    }
+
+    _slots.clear();
+    _skinnedSlots.clear();
+    _armatures.clear();
+}
+
+DRAGONBONES_NAMESPACE_END
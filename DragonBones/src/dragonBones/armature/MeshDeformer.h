@@ -0,0 +1,56 @@
+#ifndef DRAGONBONES_MESH_DEFORMER_H
+#define DRAGONBONES_MESH_DEFORMER_H
+
+#include "../core/WorkerPool.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+class Slot;
+class Armature;
+
+/**
+ * Collects the mesh slots dirtied by Armature::advanceTime while it is set as Armature::meshDeformer,
+ * deform() then skins all of them in parallel and updates their displays on the calling thread.
+ * Armatures then bake their bounds and publish their pose snapshots.
+ */
+class MeshDeformer final
+{
+private:
+    std::vector<Slot*> _slots;
+    std::vector<Slot*> _skinnedSlots;
+    std::vector<Armature*> _armatures;
+    WorkerPool _workerPool;
+    /** Slots are added from WorldClock worker threads. */
+    std::mutex _mutex;
+
+public:
+    explicit MeshDeformer(unsigned threadCount = 0);
+    ~MeshDeformer();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(MeshDeformer);
+
+public:
+    /** @private */
+    void _addSlot(Slot* value);
+    /** @private */
+    void _removeSlot(Slot* value);
+    /** @private */
+    void _addArmature(Armature* value);
+    /** @private */
+    void _removeArmature(Armature* value);
+
+public:
+    /** Call once per tick after all armatures advanced and before rendering. */
+    void deform();
+    void clear();
+
+    /** Slots added since the last deform(), including the ones disposed since. */
+    inline std::size_t getDirtyCount() const
+    {
+        return _slots.size();
+    }
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_MESH_DEFORMER_H
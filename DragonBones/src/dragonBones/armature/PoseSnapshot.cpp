@@ -0,0 +1,100 @@
+#include "PoseSnapshot.h"
+#include "Armature.h"
+#include "Slot.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+PoseSnapshot::PoseSnapshot() :
+    frame(0),
+    slots(),
+    vertices(),
+    _slotVisitor()
+{
+}
+PoseSnapshot::~PoseSnapshot()
+{
+    clear();
+}
+
+void PoseSnapshot::_capture(const Armature& armature)
+{
+    slots.clear();
+    vertices.clear();
+
+    _slotVisitor.visitArmature(armature, [this](const DrawableSlot& drawableSlot)
+    {
+        const auto slot = drawableSlot.slot;
+
+        slots.resize(slots.size() + 1);
+
+        auto& slotSnapshot = slots.back();
+        slotSnapshot.slot = slot;
+        slotSnapshot.displayIndex = slot->getDisplayIndex();
+        slotSnapshot.blendMode = slot->_blendMode;
+        slotSnapshot.textureData = drawableSlot.displayData->textureData;
+        slotSnapshot.meshData = drawableSlot.meshData;
+        slotSnapshot.transform = drawableSlot.transform; // copy
+        slotSnapshot.color = slot->_colorTransform; // copy
+        slotSnapshot.vertexStart = (unsigned)(vertices.size() / 2);
+        slotSnapshot.vertexCount = drawableSlot.vertexCount;
+
+        if (drawableSlot.meshData)
+        {
+            const auto vertexStart = vertices.size();
+            const auto valueCount = drawableSlot.vertexCount * 2;
+            vertices.insert(vertices.end(), drawableSlot.vertices, drawableSlot.vertices + valueCount);
+
+            if (drawableSlot.ffdVertices)
+            {
+                for (std::size_t iD = 0; iD < valueCount; ++iD)
+                {
+                    vertices[vertexStart + iD] += drawableSlot.ffdVertices[iD];
+                }
+            }
+        }
+    });
+}
+
+void PoseSnapshot::clear()
+{
+    frame = 0;
+    slots.clear();
+    vertices.clear();
+
+    _slotVisitor.clear();
+}
+
+PoseSnapshotBuffer::PoseSnapshotBuffer() :
+    _frame(0),
+    _writeIndex(0),
+    _readIndex(1),
+    _readyIndex(2),
+    _snapshots()
+{
+}
+PoseSnapshotBuffer::~PoseSnapshotBuffer()
+{
+}
+
+void PoseSnapshotBuffer::_publish(const Armature& armature)
+{
+    auto& snapshot = _snapshots[_writeIndex];
+    snapshot._capture(armature);
+    snapshot.frame = ++_frame;
+
+    // The snapshot the reader has not taken yet becomes the next one to write.
+    _writeIndex = _readyIndex.exchange(_writeIndex | FRESH, std::memory_order_acq_rel) & ~FRESH;
+}
+
+const PoseSnapshot* PoseSnapshotBuffer::acquire()
+{
+    if (_readyIndex.load(std::memory_order_acquire) & FRESH)
+    {
+        _readIndex = _readyIndex.exchange(_readIndex, std::memory_order_acq_rel) & ~FRESH;
+    }
+
+    const auto& snapshot = _snapshots[_readIndex];
+    return snapshot.frame > 0 ? &snapshot : nullptr;
+}
+
+DRAGONBONES_NAMESPACE_END
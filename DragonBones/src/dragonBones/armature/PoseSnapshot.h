@@ -0,0 +1,99 @@
+#ifndef DRAGONBONES_POSE_SNAPSHOT_H
+#define DRAGONBONES_POSE_SNAPSHOT_H
+
+#include "../core/DragonBones.h"
+#include "../geom/Matrix.h"
+#include "../geom/ColorTransform.h"
+#include "DrawableSlotVisitor.h"
+#include <atomic>
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+class Armature;
+class Slot;
+class MeshData;
+class TextureData;
+
+/**
+ * Drawable slot of a PoseSnapshot, child armature slots are flattened into their parents.
+ */
+class SlotSnapshot final
+{
+public:
+    /** Identifies the slot, it must not be accessed by the thread reading the snapshot. */
+    const Slot* slot;
+    int displayIndex;
+    BlendMode blendMode;
+    const TextureData* textureData;
+    /** uvs and vertexIndices of the mesh, nullptr for images. */
+    const MeshData* meshData;
+    /** Texture region (images) or vertices (meshes) to armature space. */
+    Matrix transform;
+    ColorTransform color;
+    /** Deformed mesh vertices as x, y pairs in PoseSnapshot::vertices, vertexCount 0 for images. */
+    unsigned vertexStart;
+    unsigned vertexCount;
+};
+
+/**
+ * Slot state of an armature as of one Armature::advanceTime(), it only refers to immutable data.
+ */
+class PoseSnapshot final
+{
+public:
+    /** Publish count of the armature, 0 before the first publish. */
+    unsigned frame;
+    /** Drawable slots in draw order. */
+    std::vector<SlotSnapshot> slots;
+    std::vector<float> vertices;
+
+private:
+    DrawableSlotVisitor _slotVisitor;
+
+public:
+    PoseSnapshot();
+    ~PoseSnapshot();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(PoseSnapshot);
+
+public:
+    /** @private */
+    void _capture(const Armature& armature);
+    void clear();
+};
+
+/**
+ * Triple buffer between the thread advancing an armature and a render thread, see Armature::setPoseSnapshotEnabled().
+ * Publishing never waits for the reader and the reader always gets the last completed snapshot.
+ */
+class PoseSnapshotBuffer final
+{
+private:
+    static const unsigned FRESH = 4;
+
+    unsigned _frame;
+    unsigned _writeIndex;
+    unsigned _readIndex;
+    /** Index of the last published snapshot, FRESH until the reader takes it. */
+    std::atomic<unsigned> _readyIndex;
+    PoseSnapshot _snapshots[3];
+
+public:
+    PoseSnapshotBuffer();
+    ~PoseSnapshotBuffer();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(PoseSnapshotBuffer);
+
+public:
+    /** @private */
+    void _publish(const Armature& armature);
+
+public:
+    /** Render thread only. The last published snapshot, unchanged until the next acquire(), nullptr before the first publish. */
+    const PoseSnapshot* acquire();
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_POSE_SNAPSHOT_H
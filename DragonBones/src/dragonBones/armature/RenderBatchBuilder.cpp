@@ -0,0 +1,246 @@
+#include "RenderBatchBuilder.h"
+#include "Armature.h"
+#include "Slot.h"
+#include "Crowd.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+RenderBatchBuilder::RenderBatchBuilder() :
+    vertices(),
+    indices(),
+    batches(),
+    _armature(nullptr),
+    _transform(),
+    _slotVisitor()
+{
+}
+RenderBatchBuilder::~RenderBatchBuilder()
+{
+    clear();
+}
+
+void RenderBatchBuilder::_addImage(const DrawableSlot& drawableSlot)
+{
+    const auto& slot = *drawableSlot.slot;
+    const auto& textureData = *drawableSlot.displayData->textureData;
+    const auto& matrix = drawableSlot.transform;
+    const auto& region = textureData.region;
+    auto& batch = _getBatch(slot._blendMode, textureData.parent, 4);
+    const auto vertexStart = vertices.size();
+    const auto localStart = (unsigned short)(vertexStart - batch.vertexStart);
+
+    vertices.resize(vertexStart + 4);
+
+    // Top left, top right, bottom right, bottom left.
+    const float xs[] = { 0.f, region.width, region.width, 0.f };
+    const float ys[] = { 0.f, 0.f, region.height, region.height };
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        auto& vertex = vertices[vertexStart + i];
+        vertex.x = matrix.a * xs[i] + matrix.c * ys[i] + matrix.tx;
+        vertex.y = matrix.b * xs[i] + matrix.d * ys[i] + matrix.ty;
+
+        if (textureData.rotated) // Stored 90 degrees clockwise in the atlas.
+        {
+            vertex.u = region.x + region.height - ys[i];
+            vertex.v = region.y + xs[i];
+        }
+        else
+        {
+            vertex.u = region.x + xs[i];
+            vertex.v = region.y + ys[i];
+        }
+    }
+
+    _setColor(slot, vertexStart);
+
+    const unsigned short quadIndices[] = { 0, 1, 2, 2, 3, 0 };
+    for (const auto index : quadIndices)
+    {
+        indices.push_back(localStart + index);
+    }
+
+    batch.vertexCount += 4;
+    batch.indexCount += 6;
+}
+
+void RenderBatchBuilder::_addMesh(const DrawableSlot& drawableSlot)
+{
+    const auto& slot = *drawableSlot.slot;
+    const auto& textureData = *drawableSlot.displayData->textureData;
+    const auto& matrix = drawableSlot.transform;
+    const auto& meshData = *drawableSlot.meshData;
+    const auto& region = textureData.region;
+    const auto meshVertices = drawableSlot.vertices;
+    const auto ffdVertices = drawableSlot.ffdVertices;
+    const auto vertexCount = drawableSlot.vertexCount;
+    if (vertexCount == 0 || vertexCount > MAX_BATCH_VERTEX_COUNT)
+    {
+        return;
+    }
+
+    auto& batch = _getBatch(slot._blendMode, textureData.parent, vertexCount);
+    const auto vertexStart = vertices.size();
+    const auto localStart = (unsigned short)(vertexStart - batch.vertexStart);
+
+    vertices.resize(vertexStart + vertexCount);
+
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        const auto iD = i * 2;
+        auto x = meshVertices[iD];
+        auto y = meshVertices[iD + 1];
+        if (ffdVertices)
+        {
+            x += ffdVertices[iD];
+            y += ffdVertices[iD + 1];
+        }
+
+        auto& vertex = vertices[vertexStart + i];
+        vertex.x = matrix.a * x + matrix.c * y + matrix.tx;
+        vertex.y = matrix.b * x + matrix.d * y + matrix.ty;
+        vertex.u = region.x + meshData.uvs[iD] * region.width;
+        vertex.v = region.y + meshData.uvs[iD + 1] * region.height;
+    }
+
+    _setColor(slot, vertexStart);
+
+    for (const auto index : meshData.vertexIndices)
+    {
+        indices.push_back(localStart + index);
+    }
+
+    batch.vertexCount += vertexCount;
+    batch.indexCount += (unsigned)meshData.vertexIndices.size();
+}
+
+RenderBatch& RenderBatchBuilder::_getBatch(BlendMode blendMode, TextureAtlasData* textureAtlas, std::size_t vertexCount)
+{
+    if (!batches.empty())
+    {
+        auto& batch = batches.back();
+        const auto& transform = batch.transform;
+        if (
+            batch.armature == _armature &&
+            transform.a == _transform.a && transform.b == _transform.b && transform.c == _transform.c && transform.d == _transform.d &&
+            transform.tx == _transform.tx && transform.ty == _transform.ty &&
+            batch.textureAtlas == textureAtlas &&
+            batch.blendMode == blendMode &&
+            batch.vertexCount + vertexCount <= MAX_BATCH_VERTEX_COUNT
+        )
+        {
+            return batch;
+        }
+    }
+
+    batches.resize(batches.size() + 1);
+
+    auto& batch = batches.back();
+    batch.blendMode = blendMode;
+    batch.textureAtlas = textureAtlas;
+    batch.armature = _armature;
+    batch.transform = _transform; // copy
+    batch.vertexStart = (unsigned)vertices.size();
+    batch.vertexCount = 0;
+    batch.indexStart = (unsigned)indices.size();
+    batch.indexCount = 0;
+
+    return batch;
+}
+
+void RenderBatchBuilder::_setColor(const Slot& slot, std::size_t vertexStart)
+{
+    const auto& color = slot._colorTransform;
+    const auto r = (unsigned char)(std::min(std::max(color.redMultiplier, 0.f), 1.f) * 255.f);
+    const auto g = (unsigned char)(std::min(std::max(color.greenMultiplier, 0.f), 1.f) * 255.f);
+    const auto b = (unsigned char)(std::min(std::max(color.blueMultiplier, 0.f), 1.f) * 255.f);
+    const auto a = (unsigned char)(std::min(std::max(color.alphaMultiplier, 0.f), 1.f) * 255.f);
+
+    for (std::size_t i = vertexStart, l = vertices.size(); i < l; ++i)
+    {
+        auto& vertex = vertices[i];
+        vertex.r = r;
+        vertex.g = g;
+        vertex.b = b;
+        vertex.a = a;
+    }
+}
+
+void RenderBatchBuilder::clear()
+{
+    vertices.clear();
+    indices.clear();
+    batches.clear();
+
+    _armature = nullptr;
+}
+
+void RenderBatchBuilder::addArmature(const Armature& armature, const Matrix& transform)
+{
+    _armature = &armature;
+    _transform = transform; // copy
+
+    _slotVisitor.visitArmature(armature, [this](const DrawableSlot& drawableSlot)
+    {
+        if (drawableSlot.meshData)
+        {
+            _addMesh(drawableSlot);
+        }
+        else
+        {
+            _addImage(drawableSlot);
+        }
+    });
+
+    _armature = nullptr;
+}
+
+void RenderBatchBuilder::addCrowd(const Crowd& crowd, const Matrix& transform)
+{
+    _armature = nullptr;
+    _transform = transform; // copy
+
+    for (const auto& instance : crowd.instances)
+    {
+        const auto frameIndex = crowd._getFrameIndex(instance);
+        if (frameIndex < 0)
+        {
+            continue;
+        }
+
+        const auto& matrix = instance.transform;
+        for (auto iB = crowd._frameBatchStarts[frameIndex], lB = crowd._frameBatchStarts[frameIndex + 1]; iB < lB; ++iB)
+        {
+            const auto& bakedBatch = crowd._batches[iB];
+            auto& batch = _getBatch(bakedBatch.blendMode, bakedBatch.textureAtlas, bakedBatch.vertexCount);
+            const auto vertexStart = vertices.size();
+            const auto localStart = (unsigned short)(vertexStart - batch.vertexStart);
+
+            vertices.resize(vertexStart + bakedBatch.vertexCount);
+
+            for (std::size_t i = 0; i < bakedBatch.vertexCount; ++i)
+            {
+                const auto& bakedVertex = crowd._vertices[bakedBatch.vertexStart + i];
+                auto& vertex = vertices[vertexStart + i];
+                vertex.x = matrix.a * bakedVertex.x + matrix.c * bakedVertex.y + matrix.tx;
+                vertex.y = matrix.b * bakedVertex.x + matrix.d * bakedVertex.y + matrix.ty;
+                vertex.u = bakedVertex.u;
+                vertex.v = bakedVertex.v;
+                vertex.r = (unsigned char)(bakedVertex.r * instance.r / 255);
+                vertex.g = (unsigned char)(bakedVertex.g * instance.g / 255);
+                vertex.b = (unsigned char)(bakedVertex.b * instance.b / 255);
+                vertex.a = (unsigned char)(bakedVertex.a * instance.a / 255);
+            }
+
+            for (std::size_t i = bakedBatch.indexStart, l = bakedBatch.indexStart + bakedBatch.indexCount; i < l; ++i)
+            {
+                indices.push_back(localStart + crowd._indices[i]);
+            }
+
+            batch.vertexCount += bakedBatch.vertexCount;
+            batch.indexCount += bakedBatch.indexCount;
+        }
+    }
+}
+
+DRAGONBONES_NAMESPACE_END
@@ -0,0 +1,91 @@
+#ifndef DRAGONBONES_RENDER_BATCH_BUILDER_H
+#define DRAGONBONES_RENDER_BATCH_BUILDER_H
+
+#include "../core/DragonBones.h"
+#include "../geom/Matrix.h"
+#include "DrawableSlotVisitor.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+class Armature;
+class Crowd;
+class Slot;
+class TextureAtlasData;
+
+/**
+ * Interleaved vertex.
+ * x, y: armature space (y down), map through RenderBatch::transform.
+ * u, v: not normalized, atlas pixels as TextureData::region is, divide by the atlas texture size to sample.
+ * The core TextureAtlasData has no texture size, so the renderer divides (see CCArmatureBatchDisplay::draw()).
+ */
+class RenderVertex final
+{
+public:
+    float x;
+    float y;
+    float u;
+    float v;
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+};
+
+/**
+ * Run of slots sharing texture atlas and blend mode, drawable with one call.
+ */
+class RenderBatch final
+{
+public:
+    BlendMode blendMode;
+    TextureAtlasData* textureAtlas;
+    const Armature* armature;
+    /** Armature world transform. */
+    Matrix transform;
+    unsigned vertexStart;
+    unsigned vertexCount;
+    /** Indices are relative to vertexStart. */
+    unsigned indexStart;
+    unsigned indexCount;
+};
+
+/**
+ * Walks armature slots in draw order and emits vertex and index buffers grouped into batches.
+ */
+class RenderBatchBuilder final
+{
+public:
+    static const unsigned MAX_BATCH_VERTEX_COUNT = 65535;
+
+public:
+    std::vector<RenderVertex> vertices;
+    std::vector<unsigned short> indices;
+    std::vector<RenderBatch> batches;
+
+private:
+    const Armature* _armature;
+    Matrix _transform;
+    DrawableSlotVisitor _slotVisitor;
+
+public:
+    RenderBatchBuilder();
+    ~RenderBatchBuilder();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(RenderBatchBuilder);
+
+    void _addImage(const DrawableSlot& drawableSlot);
+    void _addMesh(const DrawableSlot& drawableSlot);
+    RenderBatch& _getBatch(BlendMode blendMode, TextureAtlasData* textureAtlas, std::size_t vertexCount);
+    void _setColor(const Slot& slot, std::size_t vertexStart);
+
+public:
+    void clear();
+    /** Appends batches for armature and its child armatures, keeps the batches of previously added armatures. */
+    void addArmature(const Armature& armature, const Matrix& transform);
+    /** Appends batches for the crowd instances in order, their batches have no armature and merge only with batches of the same transform. */
+    void addCrowd(const Crowd& crowd, const Matrix& transform);
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_RENDER_BATCH_BUILDER_H
@@ -1,17 +1,31 @@
 #include "Slot.h"
 #include "Armature.h"
+#include "MeshDeformer.h"
 #include "../model/TimelineData.h"
 #include "../animation/Animation.h"
 
+#if DRAGONBONES_SIMD && defined(__AVX2__)
+#include <immintrin.h>
+#elif DRAGONBONES_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#endif
+
 DRAGONBONES_NAMESPACE_BEGIN
 
-Slot::Slot() {}
+Slot::Slot() :
+    _meshDeformer(nullptr)
+{}
 Slot::~Slot() {}
 
 void Slot::_onClear()
 {
     TransformObject::_onClear();
 
+    if (_meshDeformer)
+    {
+        _meshDeformer->_removeSlot(this);
+    }
+
     std::vector<void*> disposeDisplayList;
     for (const auto& pair : this->_displayList)
     {
@@ -43,7 +57,14 @@ void Slot::_onClear()
     _rawDisplay = nullptr;
     _meshDisplay = nullptr;
     _colorTransform.identity();
+    _ffdBegin = 0;
+    _ffdEnd = 0;
+    _ffdRuns.clear();
     _ffdVertices.clear();
+    _skinnedVertices.clear();
+    _skinnedBounds.clear();
+    _meshDeformer = nullptr;
+    _meshDeformerIndex = 0;
     _replaceDisplayDataSet.clear();
 
     _displayDirty = false;
@@ -118,6 +139,11 @@ void Slot::_updateDisplay()
 
     if (_childArmature != prevChildArmature)
     {
+        if (this->_armature)
+        {
+            this->_armature->_invalidThreadSafe();
+        }
+
         if (prevChildArmature)
         {
             prevChildArmature->_parent = nullptr;
@@ -191,12 +217,7 @@ void Slot::_updateMeshData(bool isTimelineUpdate)
                     _meshBones[i] = this->_armature->getBone(_meshData->bones[i]->name);
                 }
 
-                std::size_t ffdVerticesCount = 0;
-                for (std::size_t i = 0, l = _meshData->boneIndices.size(); i < l; ++i)
-                {
-                    ffdVerticesCount += _meshData->boneIndices[i].size();
-                }
-                _ffdVertices.resize(ffdVerticesCount * 2.f, 0.f);
+                _ffdVertices.resize(_meshData->boneIndices.size() * 2, 0.f);
             }
             else
             {
@@ -204,11 +225,17 @@ void Slot::_updateMeshData(bool isTimelineUpdate)
                 _ffdVertices.resize(_meshData->vertices.size(), 0.f);
             }
 
+            _ffdBegin = 0;
+            _ffdEnd = _ffdVertices.size();
+            _ffdRuns.assign({ 0, (unsigned)_ffdEnd });
             _ffdDirty = true;
         }
         else
         {
             _meshBones.clear();
+            _ffdBegin = 0;
+            _ffdEnd = 0;
+            _ffdRuns.clear();
             _ffdVertices.clear();
         }
 
@@ -219,6 +246,413 @@ void Slot::_updateMeshData(bool isTimelineUpdate)
     }
 }
 
+void Slot::_skinMesh(std::vector<float>& vertices, Rectangle& bounds) const
+{
+    const auto vertexCount = _meshData->boneOffsets.empty() ? 0 : _meshData->boneOffsets.size() - 1;
+
+    vertices.resize(vertexCount * 2);
+
+    if (vertexCount == 0)
+    {
+        bounds.clear();
+        return;
+    }
+
+    // FFD vertices are zero outside of the deformed range.
+    _skinVertices(*_meshData, _meshBones, _ffdVertices.empty() ? nullptr : _ffdVertices.data(), vertices.data());
+    _getVerticesBounds(vertices.data(), vertexCount, bounds);
+}
+
+void Slot::_skinVerticesScalar(const MeshData& meshData, const std::vector<Bone*>& bones, const float* ffdVertices, float* vertices)
+{
+    const auto& boneOffsets = meshData.boneOffsets;
+    const auto& boneIndices = meshData.boneIndices;
+    const auto& boneVertices = meshData.boneVertices;
+    const auto& weights = meshData.weights;
+
+    for (std::size_t i = 0, l = boneOffsets.size() - 1; i < l; ++i)
+    {
+        auto xG = 0.f;
+        auto yG = 0.f;
+        for (std::size_t iB = boneOffsets[i], lB = boneOffsets[i + 1]; iB < lB; ++iB)
+        {
+            const auto& matrix = *bones[boneIndices[iB]]->globalTransformMatrix;
+            const auto weight = weights[iB];
+            const auto iF = iB * 2;
+            const auto xL = ffdVertices ? boneVertices[iF] + ffdVertices[iF] : boneVertices[iF];
+            const auto yL = ffdVertices ? boneVertices[iF + 1] + ffdVertices[iF + 1] : boneVertices[iF + 1];
+
+            xG += (matrix.a * xL + matrix.c * yL + matrix.tx) * weight;
+            yG += (matrix.b * xL + matrix.d * yL + matrix.ty) * weight;
+        }
+
+        vertices[i * 2] = xG;
+        vertices[i * 2 + 1] = yG;
+    }
+}
+
+#if DRAGONBONES_SIMD && defined(__AVX2__)
+
+// Matrix is a, b, c, d, tx, ty, so one load gets a, b, c, d. Lanes of one influence are
+// a * x, b * x, c * y, d * y, swapping the lane pairs and adding gives x and y in the low pair.
+void Slot::_skinVertices(const MeshData& meshData, const std::vector<Bone*>& bones, const float* ffdVertices, float* vertices)
+{
+    const auto& boneOffsets = meshData.boneOffsets;
+    const auto boneIndices = meshData.boneIndices.data();
+    const auto boneVertices = meshData.boneVertices.data();
+    const auto weights = meshData.weights.data();
+
+    for (std::size_t i = 0, l = boneOffsets.size() - 1; i < l; ++i)
+    {
+        auto iB = (std::size_t)boneOffsets[i];
+        const auto lB = (std::size_t)boneOffsets[i + 1];
+        auto result = _mm256_setzero_ps();
+
+        // Two influences per step, one in each 128 bit half.
+        for (; iB + 1 < lB; iB += 2)
+        {
+            const auto& matrixA = *bones[boneIndices[iB]]->globalTransformMatrix;
+            const auto& matrixB = *bones[boneIndices[iB + 1]]->globalTransformMatrix;
+            const auto abcd = _mm256_set_m128(_mm_loadu_ps(&matrixB.a), _mm_loadu_ps(&matrixA.a));
+            const auto t = _mm256_set_m128(
+                _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&matrixB.tx),
+                _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&matrixA.tx)
+            );
+            auto local = _mm_loadu_ps(boneVertices + iB * 2);
+            if (ffdVertices)
+            {
+                local = _mm_add_ps(local, _mm_loadu_ps(ffdVertices + iB * 2));
+            }
+
+            const auto xxyy = _mm256_set_m128(_mm_unpackhi_ps(local, local), _mm_unpacklo_ps(local, local));
+            const auto weight = _mm256_set_m128(_mm_set1_ps(weights[iB + 1]), _mm_set1_ps(weights[iB]));
+            auto global = _mm256_mul_ps(abcd, xxyy);
+            global = _mm256_add_ps(global, _mm256_permute_ps(global, _MM_SHUFFLE(1, 0, 3, 2)));
+            result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_add_ps(global, t), weight));
+        }
+
+        auto resultXY = _mm_add_ps(_mm256_castps256_ps128(result), _mm256_extractf128_ps(result, 1));
+
+        if (iB < lB)
+        {
+            const auto& matrix = *bones[boneIndices[iB]]->globalTransformMatrix;
+            auto local = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(boneVertices + iB * 2));
+            if (ffdVertices)
+            {
+                local = _mm_add_ps(local, _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(ffdVertices + iB * 2)));
+            }
+
+            auto global = _mm_mul_ps(_mm_loadu_ps(&matrix.a), _mm_unpacklo_ps(local, local));
+            global = _mm_add_ps(global, _mm_movehl_ps(global, global));
+            global = _mm_add_ps(global, _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&matrix.tx));
+            resultXY = _mm_add_ps(resultXY, _mm_mul_ps(global, _mm_set1_ps(weights[iB])));
+        }
+
+        _mm_storel_pi((__m64*)(vertices + i * 2), resultXY);
+    }
+}
+
+void Slot::_getVerticesBounds(const float* vertices, std::size_t vertexCount, Rectangle& bounds)
+{
+    const auto count = vertexCount * 2;
+    __m256 min;
+    __m256 max;
+    std::size_t i = 0;
+
+    // Four vertices per step, the lanes alternate x and y.
+    if (count >= 8)
+    {
+        min = max = _mm256_loadu_ps(vertices);
+        for (i = 8; i + 8 <= count; i += 8)
+        {
+            const auto value = _mm256_loadu_ps(vertices + i);
+            min = _mm256_min_ps(min, value);
+            max = _mm256_max_ps(max, value);
+        }
+    }
+    else
+    {
+        min = max = _mm256_set_ps(vertices[1], vertices[0], vertices[1], vertices[0], vertices[1], vertices[0], vertices[1], vertices[0]);
+        i = 2;
+    }
+
+    auto min4 = _mm_min_ps(_mm256_castps256_ps128(min), _mm256_extractf128_ps(min, 1));
+    auto max4 = _mm_max_ps(_mm256_castps256_ps128(max), _mm256_extractf128_ps(max, 1));
+    min4 = _mm_min_ps(min4, _mm_movehl_ps(min4, min4));
+    max4 = _mm_max_ps(max4, _mm_movehl_ps(max4, max4));
+
+    float minXY[4];
+    float maxXY[4];
+    _mm_storeu_ps(minXY, min4);
+    _mm_storeu_ps(maxXY, max4);
+
+    for (; i < count; i += 2)
+    {
+        minXY[0] = std::min(minXY[0], vertices[i]);
+        maxXY[0] = std::max(maxXY[0], vertices[i]);
+        minXY[1] = std::min(minXY[1], vertices[i + 1]);
+        maxXY[1] = std::max(maxXY[1], vertices[i + 1]);
+    }
+
+    bounds.x = minXY[0];
+    bounds.y = minXY[1];
+    bounds.width = maxXY[0] - minXY[0];
+    bounds.height = maxXY[1] - minXY[1];
+}
+
+#elif DRAGONBONES_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+
+// Matrix is a, b, c, d, tx, ty, so one load gets a, b, c, d. Lanes of one influence are
+// a * x, b * x, c * y, d * y, adding the halves gives x and y.
+void Slot::_skinVertices(const MeshData& meshData, const std::vector<Bone*>& bones, const float* ffdVertices, float* vertices)
+{
+    const auto& boneOffsets = meshData.boneOffsets;
+    const auto boneIndices = meshData.boneIndices.data();
+    const auto boneVertices = meshData.boneVertices.data();
+    const auto weights = meshData.weights.data();
+
+    for (std::size_t i = 0, l = boneOffsets.size() - 1; i < l; ++i)
+    {
+        auto result = vdup_n_f32(0.f);
+        for (std::size_t iB = boneOffsets[i], lB = boneOffsets[i + 1]; iB < lB; ++iB)
+        {
+            const auto& matrix = *bones[boneIndices[iB]]->globalTransformMatrix;
+            auto local = vld1_f32(boneVertices + iB * 2);
+            if (ffdVertices)
+            {
+                local = vadd_f32(local, vld1_f32(ffdVertices + iB * 2));
+            }
+
+            const auto global = vmulq_f32(vld1q_f32(&matrix.a), vcombine_f32(vdup_lane_f32(local, 0), vdup_lane_f32(local, 1)));
+            const auto globalXY = vadd_f32(vadd_f32(vget_low_f32(global), vget_high_f32(global)), vld1_f32(&matrix.tx));
+            result = vmla_n_f32(result, globalXY, weights[iB]);
+        }
+
+        vst1_f32(vertices + i * 2, result);
+    }
+}
+
+void Slot::_getVerticesBounds(const float* vertices, std::size_t vertexCount, Rectangle& bounds)
+{
+    const auto count = vertexCount * 2;
+    auto min = vld1_f32(vertices);
+    auto max = min;
+    std::size_t i = 2;
+
+    // Two vertices per step, the lanes alternate x and y.
+    if (count >= 4)
+    {
+        auto min4 = vld1q_f32(vertices);
+        auto max4 = min4;
+        for (i = 4; i + 4 <= count; i += 4)
+        {
+            const auto value = vld1q_f32(vertices + i);
+            min4 = vminq_f32(min4, value);
+            max4 = vmaxq_f32(max4, value);
+        }
+
+        min = vmin_f32(vget_low_f32(min4), vget_high_f32(min4));
+        max = vmax_f32(vget_low_f32(max4), vget_high_f32(max4));
+    }
+
+    for (; i < count; i += 2)
+    {
+        const auto value = vld1_f32(vertices + i);
+        min = vmin_f32(min, value);
+        max = vmax_f32(max, value);
+    }
+
+    bounds.x = vget_lane_f32(min, 0);
+    bounds.y = vget_lane_f32(min, 1);
+    bounds.width = vget_lane_f32(max, 0) - bounds.x;
+    bounds.height = vget_lane_f32(max, 1) - bounds.y;
+}
+
+#else
+
+void Slot::_skinVertices(const MeshData& meshData, const std::vector<Bone*>& bones, const float* ffdVertices, float* vertices)
+{
+    _skinVerticesScalar(meshData, bones, ffdVertices, vertices);
+}
+
+void Slot::_getVerticesBounds(const float* vertices, std::size_t vertexCount, Rectangle& bounds)
+{
+    auto minX = vertices[0];
+    auto minY = vertices[1];
+    auto maxX = minX;
+    auto maxY = minY;
+    for (std::size_t i = 2, l = vertexCount * 2; i < l; i += 2)
+    {
+        minX = std::min(minX, vertices[i]);
+        maxX = std::max(maxX, vertices[i]);
+        minY = std::min(minY, vertices[i + 1]);
+        maxY = std::max(maxY, vertices[i + 1]);
+    }
+
+    bounds.x = minX;
+    bounds.y = minY;
+    bounds.width = maxX - minX;
+    bounds.height = maxY - minY;
+}
+
+#endif // DRAGONBONES_SIMD
+
+DisplayData* Slot::_getCurrentDisplayData(DisplayData** rawDisplayData) const
+{
+    if (!_displayDataSet || _displayIndex < 0)
+    {
+        return nullptr;
+    }
+
+    const unsigned displayIndex = _displayIndex;
+    const auto rawData = displayIndex < _displayDataSet->displays.size() ? _displayDataSet->displays[displayIndex] : nullptr;
+    const auto replaceData = displayIndex < _replaceDisplayDataSet.size() ? _replaceDisplayDataSet[displayIndex] : nullptr;
+
+    if (rawDisplayData)
+    {
+        *rawDisplayData = rawData;
+    }
+
+    return replaceData ? replaceData : rawData;
+}
+
+void Slot::_getImageRect(const DisplayData& currentDisplayData, const DisplayData* rawDisplayData, Rectangle& rect) const
+{
+    const auto textureData = currentDisplayData.textureData;
+    auto pivotX = currentDisplayData.pivot.x;
+    auto pivotY = currentDisplayData.pivot.y;
+
+    if (currentDisplayData.isRelativePivot)
+    {
+        const auto& rectData = textureData->frame ? *textureData->frame : textureData->region;
+        auto width = rectData.width;
+        auto height = rectData.height;
+        if (!textureData->frame && textureData->rotated)
+        {
+            width = rectData.height;
+            height = rectData.width;
+        }
+
+        pivotX *= width;
+        pivotY *= height;
+    }
+
+    if (textureData->frame)
+    {
+        pivotX += textureData->frame->x;
+        pivotY += textureData->frame->y;
+    }
+
+    if (rawDisplayData && &currentDisplayData != rawDisplayData)
+    {
+        pivotX += currentDisplayData.transform.x - rawDisplayData->transform.x;
+        pivotY += currentDisplayData.transform.y - rawDisplayData->transform.y;
+    }
+
+    rect.x = -pivotX;
+    rect.y = -pivotY;
+    rect.width = textureData->region.width;
+    rect.height = textureData->region.height;
+}
+
+bool Slot::_getDisplayBounds(Rectangle& bounds) const
+{
+    if (!_display)
+    {
+        return false;
+    }
+
+    Rectangle rect;
+
+    if (_childArmature)
+    {
+        const auto& childBounds = _childArmature->getBounds();
+        if (childBounds.width <= 0.f && childBounds.height <= 0.f)
+        {
+            return false;
+        }
+
+        rect = childBounds; // copy
+    }
+    else
+    {
+        DisplayData* rawDisplayData = nullptr;
+        const auto currentDisplayData = _getCurrentDisplayData(&rawDisplayData);
+        if (!currentDisplayData || !currentDisplayData->textureData)
+        {
+            return false;
+        }
+
+        if (_meshData && _display == _meshDisplay)
+        {
+            if (_meshData->skinned)
+            {
+                bounds = _skinnedBounds; // copy, already in armature space.
+                return !_skinnedVertices.empty();
+            }
+
+            const auto& vertices = _meshData->vertices;
+            const auto hasFFD = !_ffdVertices.empty();
+            if (vertices.empty())
+            {
+                return false;
+            }
+
+            auto minX = vertices[0] + (hasFFD ? _ffdVertices[0] : 0.f);
+            auto minY = vertices[1] + (hasFFD ? _ffdVertices[1] : 0.f);
+            auto maxX = minX;
+            auto maxY = minY;
+            for (std::size_t i = 2, l = vertices.size(); i < l; i += 2)
+            {
+                const auto x = vertices[i] + (hasFFD ? _ffdVertices[i] : 0.f);
+                const auto y = vertices[i + 1] + (hasFFD ? _ffdVertices[i + 1] : 0.f);
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+                minY = std::min(minY, y);
+                maxY = std::max(maxY, y);
+            }
+
+            rect.x = minX;
+            rect.y = minY;
+            rect.width = maxX - minX;
+            rect.height = maxY - minY;
+        }
+        else
+        {
+            _getImageRect(*currentDisplayData, rawDisplayData, rect);
+        }
+    }
+
+    const auto& matrix = *this->globalTransformMatrix;
+    const float xs[] = { rect.x, rect.x + rect.width, rect.x + rect.width, rect.x };
+    const float ys[] = { rect.y, rect.y, rect.y + rect.height, rect.y + rect.height };
+    auto minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        const auto x = matrix.a * xs[i] + matrix.c * ys[i] + matrix.tx;
+        const auto y = matrix.b * xs[i] + matrix.d * ys[i] + matrix.ty;
+        if (i == 0)
+        {
+            minX = maxX = x;
+            minY = maxY = y;
+        }
+        else
+        {
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+        }
+    }
+
+    bounds.x = minX;
+    bounds.y = minY;
+    bounds.width = maxX - minX;
+    bounds.height = maxY - minY;
+
+    return true;
+}
+
 void Slot::_update(int cacheFrameIndex)
 {
     _blendIndex = 0;
@@ -251,7 +685,20 @@ void Slot::_update(int cacheFrameIndex)
         if (_ffdDirty || (_meshData->skinned && _isMeshBonesUpdate()))
         {
             _ffdDirty = false;
-            _updateMesh();
+
+            if (Armature::meshDeformer)
+            {
+                Armature::meshDeformer->_addSlot(this);
+            }
+            else
+            {
+                if (_meshData->skinned)
+                {
+                    _skinMesh(_skinnedVertices, _skinnedBounds);
+                }
+
+                _updateMesh();
+            }
         }
 
         if (_meshData->skinned)
@@ -392,11 +839,42 @@ bool Slot::_setColor(const ColorTransform& value)
     return true;
 }
 
+void Slot::invalidUpdate()
+{
+    _displayDirty = true;
+
+    if (this->_armature)
+    {
+        this->_armature->setPoseOverridden(true);
+        this->_armature->wakeUp();
+    }
+}
+
 void Slot::setDisplayIndex(int value)
 {
     if (_setDisplayIndex(value))
     {
         _update(-1);
+
+        if (this->_armature)
+        {
+            this->_armature->setPoseOverridden(true);
+            this->_armature->wakeUp();
+        }
+    }
+}
+
+void Slot::setColor(const ColorTransform& value)
+{
+    if (_setColor(value))
+    {
+        _update(-1);
+
+        if (this->_armature)
+        {
+            this->_armature->setPoseOverridden(true);
+            this->_armature->wakeUp();
+        }
     }
 }
 
@@ -409,6 +887,12 @@ void Slot::setDisplayList(const std::vector<std::pair<void*, DisplayType>>& valu
     if (_setDisplayList(value))
     {
         _update(-1);
+
+        if (this->_armature)
+        {
+            this->_armature->setPoseOverridden(true);
+            this->_armature->wakeUp();
+        }
     }
 
     for (const auto& pair : backupDisplayList)
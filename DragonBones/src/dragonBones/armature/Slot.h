@@ -2,11 +2,14 @@
 #define DRAGONBONES_SLOT_H
 
 #include "TransformObject.h"
+#include "../geom/Rectangle.h"
 #include "../model/ArmatureData.h"
 #include "Bone.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+class MeshDeformer;
+
 class Slot : public TransformObject
 {
 public:
@@ -37,8 +40,22 @@ public: // private friend class
     /** @private */
     ColorTransform _colorTransform;
     /** @private */
+    std::size_t _ffdBegin;
+    /** @private */
+    std::size_t _ffdEnd;
+    /** @private Runs of _ffdVertices that may be non zero, _ffdBegin and _ffdEnd span them. */
+    std::vector<unsigned> _ffdRuns;
+    /** @private */
     std::vector<float> _ffdVertices;
     /** @private */
+    std::vector<float> _skinnedVertices;
+    /** @private */
+    Rectangle _skinnedBounds;
+    /** @private */
+    MeshDeformer* _meshDeformer;
+    /** @private Index in the dirty slots of _meshDeformer. */
+    std::size_t _meshDeformerIndex;
+    /** @private */
     std::vector<DisplayData*> _replaceDisplayDataSet;
 
 protected:
@@ -71,7 +88,6 @@ protected:
     virtual void _updateColor() = 0;
     virtual void _updateFilters() = 0;
     virtual void _updateFrame() = 0;
-    virtual void _updateMesh() = 0;
     virtual void _updateTransform() = 0;
     void _updateDisplay();
 
@@ -106,6 +122,13 @@ public:
     virtual void _updateVisible() = 0;
     /** @private */
     virtual void _updateBlendMode() = 0;
+    /** @private Skinned meshes read _skinnedVertices and _skinnedBounds. */
+    virtual void _updateMesh() = 0;
+    /** @private Display updates touch no shared render state, so the slot may update on a WorldClock worker thread. */
+    virtual bool _isThreadSafe() const
+    {
+        return false;
+    }
 
     /** @private */
     virtual void _setArmature(Armature* value) override;
@@ -114,6 +137,23 @@ public:
     /** @private */
     void _update(int cacheFrameIndex);
     /** @private */
+    void _skinMesh(std::vector<float>& vertices, Rectangle& bounds) const;
+    /**
+     * @private Blends the influences of meshData by the global matrices of bones into vertices as x, y pairs.
+     * ffdVertices is nullptr or holds one x, y offset per influence. Runs the DRAGONBONES_SIMD kernel if there is one.
+     */
+    static void _skinVertices(const MeshData& meshData, const std::vector<Bone*>& bones, const float* ffdVertices, float* vertices);
+    /** @private Scalar kernel of _skinVertices(). */
+    static void _skinVerticesScalar(const MeshData& meshData, const std::vector<Bone*>& bones, const float* ffdVertices, float* vertices);
+    /** @private vertexCount x, y pairs, vertexCount > 0. */
+    static void _getVerticesBounds(const float* vertices, std::size_t vertexCount, Rectangle& bounds);
+    /** @private */
+    DisplayData* _getCurrentDisplayData(DisplayData** rawDisplayData = nullptr) const;
+    /** @private Image rectangle in slot space, the pivot is at the origin. */
+    void _getImageRect(const DisplayData& currentDisplayData, const DisplayData* rawDisplayData, Rectangle& rect) const;
+    /** @private Bounds of the current display in armature space, false when nothing is shown. */
+    bool _getDisplayBounds(Rectangle& bounds) const;
+    /** @private */
     bool _setDisplayList(const std::vector<std::pair<void*, DisplayType>>& value);
     /** @private */
     bool _setDisplayIndex(int value);
@@ -123,10 +163,7 @@ public:
     bool _setColor(const ColorTransform& value);
 
 public:
-    inline void invalidUpdate() 
-    {
-        _displayDirty = true;
-    }
+    void invalidUpdate();
 
     inline void* getRawDisplay() const
     {
@@ -144,6 +181,13 @@ public:
     }
     void setDisplayIndex(int value);
 
+    inline const ColorTransform& getColor() const
+    {
+        return _colorTransform;
+    }
+    /** Slot timelines overwrite it on their next key frame. */
+    void setColor(const ColorTransform& value);
+
     inline const std::vector<std::pair<void*, DisplayType>>& getDisplayList() const
     {
         return _displayList;
@@ -5,9 +5,12 @@ std::size_t BaseObject::_hashCode = 0;
 std::size_t BaseObject::_defaultMaxCount = 5000;
 std::map<std::size_t, std::size_t> BaseObject::_maxCountMap;
 std::map<std::size_t, std::vector<BaseObject*>> BaseObject::_poolsMap;
+std::recursive_mutex BaseObject::_poolMutex;
 
 void BaseObject::_returnObject(BaseObject* object)
 {
+    std::lock_guard<std::recursive_mutex> lock(_poolMutex);
+
     const auto classTypeIndex = object->getClassTypeIndex();
     const auto maxCountIterator = _maxCountMap.find(classTypeIndex);
     const auto maxCount = maxCountIterator != _maxCountMap.end() ? maxCountIterator->second : _defaultMaxCount;
@@ -32,6 +35,8 @@ void BaseObject::_returnObject(BaseObject* object)
 
 void BaseObject::setMaxCount(std::size_t classTypeIndex, std::size_t maxCount)
 {
+    std::lock_guard<std::recursive_mutex> lock(_poolMutex);
+
     if (classTypeIndex)
     {
         _maxCountMap[classTypeIndex] = maxCount;
@@ -76,6 +81,8 @@ void BaseObject::setMaxCount(std::size_t classTypeIndex, std::size_t maxCount)
 
 void BaseObject::clearPool(std::size_t classTypeIndex)
 {
+    std::lock_guard<std::recursive_mutex> lock(_poolMutex);
+
     if (classTypeIndex)
     {
         const auto iterator = _poolsMap.find(classTypeIndex);
@@ -2,6 +2,7 @@
 #define DRAGONBONES_BASE_OBJECT_H
 
 #include "DragonBones.h"
+#include <mutex>
 
 #define BIND_CLASS_TYPE(CLASS) \
 public:\
@@ -24,6 +25,8 @@ private:
     static std::size_t _defaultMaxCount;
     static std::map<std::size_t, std::size_t> _maxCountMap;
     static std::map<std::size_t, std::vector<BaseObject*>> _poolsMap;
+    /** Armatures may advance on WorldClock worker threads, constructors and destructors borrow and return recursively. */
+    static std::recursive_mutex _poolMutex;
 
     static void _returnObject(BaseObject *object);
 
@@ -34,6 +37,8 @@ public:
     template<typename T>
     static T* borrowObject() 
     {
+        std::lock_guard<std::recursive_mutex> lock(_poolMutex);
+
         const auto classTypeIndex = T::getTypeIndex();
         const auto iterator = _poolsMap.find(classTypeIndex);
         if (iterator != _poolsMap.end())
@@ -18,6 +18,15 @@
     } while (0)
 #endif
 
+// dragonBones SIMD kernels, on where the compiler targets AVX2 or NEON, define DRAGONBONES_SIMD 0 to use the scalar ones
+#ifndef DRAGONBONES_SIMD
+#if defined(__AVX2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DRAGONBONES_SIMD 1
+#else
+#define DRAGONBONES_SIMD 0
+#endif
+#endif
+
 // namespace dragonBones {}
 #define DRAGONBONES_NAMESPACE_BEGIN namespace dragonBones {
 #define DRAGONBONES_NAMESPACE_END }
@@ -76,6 +85,19 @@ enum class EventType {
     Sound = 1
 };
 
+/** Type of an EventObject, also its bit in IEventDispatcher::getEventMask(). */
+enum class EventObjectType {
+    Start = 0,
+    LoopComplete = 1,
+    Complete = 2,
+    FadeIn = 3,
+    FadeInComplete = 4,
+    FadeOut = 5,
+    FadeOutComplete = 6,
+    Frame = 7,
+    Sound = 8
+};
+
 enum class ActionType {
     Play = 0,
     Stop = 1,
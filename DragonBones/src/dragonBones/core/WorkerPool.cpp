@@ -0,0 +1,109 @@
+#include "WorkerPool.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+WorkerPool::WorkerPool(unsigned threadCount) :
+    _stopped(false),
+    _generation(0),
+    _count(0),
+    _doneCount(0),
+    _next(0),
+    _task(nullptr),
+    _threads(),
+    _mutex(),
+    _wakeCondition(),
+    _doneCondition()
+{
+    for (unsigned i = 0; i < threadCount; ++i)
+    {
+        _threads.push_back(std::thread(&WorkerPool::_work, this));
+    }
+}
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+
+    _wakeCondition.notify_all();
+
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::_work()
+{
+    unsigned generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeCondition.wait(lock, [this, generation]() { return _stopped || _generation != generation; });
+
+            if (_stopped)
+            {
+                return;
+            }
+
+            generation = _generation;
+        }
+
+        _run();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (++_doneCount == _threads.size())
+            {
+                _doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void WorkerPool::_run()
+{
+    // Indices are claimed one at a time, so threads that finish early take over the remaining work.
+    for (auto i = _next++; i < _count; i = _next++)
+    {
+        (*_task)(i);
+    }
+}
+
+void WorkerPool::parallelFor(std::size_t count, const Task& task)
+{
+    if (_threads.empty() || count < 2)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _count = count;
+        _doneCount = 0;
+        _next = 0;
+        _generation++;
+    }
+
+    _wakeCondition.notify_all();
+
+    _run();
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _doneCondition.wait(lock, [this]() { return _doneCount == _threads.size(); });
+        _task = nullptr;
+        _count = 0;
+    }
+}
+
+DRAGONBONES_NAMESPACE_END
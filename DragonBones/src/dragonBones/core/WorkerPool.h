@@ -0,0 +1,54 @@
+#ifndef DRAGONBONES_WORKER_POOL_H
+#define DRAGONBONES_WORKER_POOL_H
+
+#include "DragonBones.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+DRAGONBONES_NAMESPACE_BEGIN
+/**
+ * Fixed set of worker threads running index ranges in parallel with the calling thread.
+ * @private
+ */
+class WorkerPool final
+{
+public:
+    typedef std::function<void(std::size_t)> Task;
+
+private:
+    bool _stopped;
+    unsigned _generation;
+    std::size_t _count;
+    std::size_t _doneCount;
+    std::atomic<std::size_t> _next;
+    const Task* _task;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _doneCondition;
+
+public:
+    /** threadCount extra threads, 0 runs every task on the calling thread. */
+    explicit WorkerPool(unsigned threadCount = 0);
+    ~WorkerPool();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(WorkerPool);
+
+    void _work();
+    void _run();
+
+public:
+    /** Calls task(0) to task(count - 1) and returns once all of them finished, not reentrant. */
+    void parallelFor(std::size_t count, const Task& task);
+
+    inline unsigned getThreadCount() const
+    {
+        return (unsigned)_threads.size();
+    }
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_WORKER_POOL_H
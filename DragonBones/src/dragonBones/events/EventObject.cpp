@@ -14,6 +14,19 @@ const char* EventObject::FADE_OUT_COMPLETE = "fadeOutComplete";
 const char* EventObject::FRAME_EVENT = "frameEvent";
 const char* EventObject::SOUND_EVENT = "soundEvent";
 
+const std::string& EventObject::getTypeName(EventObjectType type)
+{
+    // Indexed by EventObjectType, built once so dispatching does not create strings.
+    static const std::string TYPE_NAMES[TYPE_COUNT] =
+    {
+        START, LOOP_COMPLETE, COMPLETE,
+        FADE_IN, FADE_IN_COMPLETE, FADE_OUT, FADE_OUT_COMPLETE,
+        FRAME_EVENT, SOUND_EVENT
+    };
+
+    return TYPE_NAMES[(unsigned)type];
+}
+
 EventObject::EventObject()
 {
     _onClear();
@@ -26,14 +39,28 @@ EventObject::~EventObject()
 
 void EventObject::_onClear()
 {
-    type.clear();
-    name.clear();
+    type = EventObjectType::Start;
     //data = null;
     userData = nullptr;
     armature = nullptr;
     bone = nullptr;
     slot = nullptr;
     animationState = nullptr;
+    _name = nullptr;
+}
+
+unsigned IEventDispatcher::getEventMask() const
+{
+    unsigned mask = 0;
+    for (unsigned i = 0; i < EventObject::TYPE_COUNT; ++i)
+    {
+        if (hasEvent(EventObject::getTypeName((EventObjectType)i)))
+        {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
 }
 
 DRAGONBONES_NAMESPACE_END
\ No newline at end of file
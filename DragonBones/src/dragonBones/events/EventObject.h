@@ -27,9 +27,13 @@ public:
     static const char* FRAME_EVENT;
     static const char* SOUND_EVENT;
 
+    static const unsigned TYPE_COUNT = 9;
+
+    /** One of the type names above, for dispatchers keyed by string. */
+    static const std::string& getTypeName(EventObjectType type);
+
 public:
-    std::string type;
-    std::string name;
+    EventObjectType type;
     //void* data; // TODO
     void* userData;
     Armature* armature;
@@ -37,6 +41,10 @@ public:
     Slot* slot;
     AnimationState* animationState;
 
+public: // private
+    /** @private Name in the event data, nullptr for animation and fade events. */
+    const std::string* _name;
+
 public:
     EventObject();
     ~EventObject();
@@ -46,6 +54,14 @@ protected:
 
 private:
     DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(EventObject);
+
+public:
+    /** Frame or sound event name, empty for the other types. */
+    inline const std::string& getName() const
+    {
+        static const std::string EMPTY_NAME;
+        return _name ? *_name : EMPTY_NAME;
+    }
 };
 
 class IEventDispatcher
@@ -61,6 +77,16 @@ public:
     virtual void _dispatchEvent(EventObject* value) = 0;
 
     virtual bool hasEvent(const std::string& type) const = 0;
+    /**
+     * Bit 1 << EventObjectType of every type that has listeners, events of the other types are never created.
+     * The default asks hasEvent() for each type, an armature asks at most once per advanceTime().
+     */
+    virtual unsigned getEventMask() const;
+
+    inline bool hasEvent(EventObjectType type) const
+    {
+        return (getEventMask() & (1u << (unsigned)type)) != 0;
+    }
 };
 
 DRAGONBONES_NAMESPACE_END
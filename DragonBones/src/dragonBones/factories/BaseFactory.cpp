@@ -4,6 +4,7 @@ DRAGONBONES_NAMESPACE_BEGIN
 
 BaseFactory::BaseFactory() :
     autoSearch(false),
+    keyFrameTolerance(0.001f),
 
     _jsonDataParser(),
     _dragonBonesDataMap(),
@@ -213,6 +214,7 @@ void BaseFactory::_replaceSlotDisplay(const BuildArmaturePackage& dataPackage, D
 
 DragonBonesData* BaseFactory::parseDragonBonesData(const char* rawData, const std::string& dragonBonesName, float scale)
 {
+    _jsonDataParser.keyFrameTolerance = keyFrameTolerance;
     const auto dragonBonesData = _jsonDataParser.parseDragonBonesData(rawData, scale);
     addDragonBonesData(dragonBonesData, dragonBonesName);
 
@@ -38,6 +38,8 @@ class BaseFactory
 {
 public:
     bool autoSearch;
+    /** @see DataParser::keyFrameTolerance */
+    float keyFrameTolerance;
 
 protected:
     JSONDataParser _jsonDataParser;
@@ -17,6 +17,7 @@ void AnimationData::_onClear()
     TimelineData::_onClear();
 
     hasBoneTimelineEvent = false;
+    hasSlotTimelineEvent = false;
     hasAsynchronyTimeline = false;
     frameCount = 0;
     playTimes = 0;
@@ -52,6 +53,9 @@ void AnimationData::_onClear()
     slotTimelines.clear();
     ffdTimelines.clear();
     cachedFrames.clear();
+    skinBounds.clear();
+    sharedPoses.clear();
+    sharedPoseTicks.clear();
 }
 
 void AnimationData::cacheFrames(float value)
@@ -66,6 +70,10 @@ void AnimationData::cacheFrames(float value)
     cacheTimeToFrameScale = cacheFrameCount / (duration + 0.0000001f);
     cachedFrames.resize(cacheFrameCount, false);
 
+    skinBounds.clear();
+    sharedPoses.assign(cacheFrameCount, nullptr);
+    sharedPoseTicks.assign(cacheFrameCount, 0);
+
     for (const auto& pair : boneTimelines)
     {
         pair.second->cacheFrames(cacheFrameCount);
@@ -77,6 +85,44 @@ void AnimationData::cacheFrames(float value)
     }
 }
 
+void AnimationData::cacheBounds(const SkinData* skin, std::size_t cacheFrameIndex, const Rectangle& bounds)
+{
+    if (cacheFrameIndex >= cachedFrames.size())
+    {
+        return;
+    }
+
+    auto& boundsData = skinBounds[skin];
+    if (boundsData.cachedFrames.empty())
+    {
+        boundsData.cachedBounds.assign(cachedFrames.size(), Rectangle());
+        boundsData.cachedFrames.assign(cachedFrames.size(), false);
+    }
+
+    if (boundsData.cachedFrames[cacheFrameIndex])
+    {
+        return;
+    }
+
+    boundsData.cachedFrames[cacheFrameIndex] = true;
+    boundsData.cachedBounds[cacheFrameIndex] = bounds;
+
+    auto& clipBounds = boundsData.clipBounds;
+    if (boundsData.cachedCount++ == 0)
+    {
+        clipBounds = bounds;
+    }
+    else
+    {
+        const auto right = std::max(clipBounds.x + clipBounds.width, bounds.x + bounds.width);
+        const auto bottom = std::max(clipBounds.y + clipBounds.height, bounds.y + bounds.height);
+        clipBounds.x = std::min(clipBounds.x, bounds.x);
+        clipBounds.y = std::min(clipBounds.y, bounds.y);
+        clipBounds.width = right - clipBounds.x;
+        clipBounds.height = bottom - clipBounds.y;
+    }
+}
+
 void AnimationData::addBoneTimeline(BoneTimelineData* value)
 {
     if (value && value->bone && boneTimelines.find(value->bone->name) == boneTimelines.end())
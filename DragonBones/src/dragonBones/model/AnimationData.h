@@ -2,9 +2,28 @@
 #define DRAGONBONES_ANIMATION_DATA_H
 
 #include "TimelineData.h"
+#include "../geom/Rectangle.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+class Armature;
+
+/**
+ * @private Armature bounds per cache frame of one skin, displays differ per skin so bounds are never shared across skins.
+ */
+class AnimationBoundsData final
+{
+public:
+    std::vector<Rectangle> cachedBounds;
+    std::vector<bool> cachedFrames;
+    std::size_t cachedCount;
+    /** Union of the cached frame bounds, only exposed once every cache frame is cached. */
+    Rectangle clipBounds;
+
+    AnimationBoundsData() : cachedBounds(), cachedFrames(), cachedCount(0), clipBounds() {}
+    ~AnimationBoundsData() {}
+};
+
 class AnimationData final : public TimelineData<AnimationFrameData>
 {
     BIND_CLASS_TYPE(AnimationData);
@@ -14,6 +33,8 @@ public:
     bool hasAsynchronyTimeline;
     /** @private */
     bool hasBoneTimelineEvent;
+    /** @private */
+    bool hasSlotTimelineEvent;
     unsigned frameCount;
     unsigned playTimes;
     float position;
@@ -32,6 +53,12 @@ public:
     std::map<std::string, std::map<std::string, std::map<std::string, FFDTimelineData*>>> ffdTimelines; // skin slot displayIndex
     /** @private */
     std::vector<bool> cachedFrames;
+    /** @private */
+    std::map<const SkinData*, AnimationBoundsData> skinBounds;
+    /** @private Armature that evaluated each cache frame, valid in the tick of sharedPoseTicks. See Armature::getPoseSource(). */
+    std::vector<Armature*> sharedPoses;
+    /** @private */
+    std::vector<unsigned> sharedPoseTicks;
 
     /** @private */
     AnimationData();
@@ -48,6 +75,8 @@ public:
     /** @private */
     void cacheFrames(float value);
     /** @private */
+    void cacheBounds(const SkinData* skin, std::size_t cacheFrameIndex, const Rectangle& bounds);
+    /** @private */
     void addBoneTimeline(BoneTimelineData* value);
     /** @private */
     void addSlotTimeline(SlotTimelineData* value);
@@ -83,6 +112,44 @@ public:
 
         return nullptr;
     }
+
+    /** @private */
+    inline const Rectangle* getCachedBounds(const SkinData* skin, std::size_t cacheFrameIndex) const
+    {
+        const auto iterator = skinBounds.find(skin);
+        if (iterator != skinBounds.end())
+        {
+            const auto& boundsData = iterator->second;
+            if (cacheFrameIndex < boundsData.cachedFrames.size() && boundsData.cachedFrames[cacheFrameIndex])
+            {
+                return &boundsData.cachedBounds[cacheFrameIndex];
+            }
+        }
+
+        return nullptr;
+    }
+
+    /** Union of the bounds of every cache frame played with the skin, nullptr while any cache frame is missing. */
+    inline const Rectangle* getClipBounds(const SkinData* skin) const
+    {
+        const auto iterator = skinBounds.find(skin);
+        if (iterator != skinBounds.end())
+        {
+            const auto& boundsData = iterator->second;
+            if (!boundsData.cachedBounds.empty() && boundsData.cachedCount == boundsData.cachedBounds.size())
+            {
+                return &boundsData.clipBounds;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /** Every cache frame of the clip has been played once with the skin and a cache frame rate set. */
+    inline bool hasCompleteClipBounds(const SkinData* skin) const
+    {
+        return getClipBounds(skin) != nullptr;
+    }
 };
 
 DRAGONBONES_NAMESPACE_END
@@ -78,6 +78,7 @@ void MeshData::_onClear()
     uvs.clear();
     vertices.clear();
     vertexIndices.clear();
+    boneOffsets.clear();
     boneIndices.clear();
     weights.clear();
     boneVertices.clear();
@@ -105,9 +105,11 @@ public:
     std::vector<float> vertices;
     std::vector<unsigned short> vertexIndices;
 
-    std::vector<std::vector<unsigned short>> boneIndices;
-    std::vector<std::vector<float>> weights;
-    std::vector<std::vector<float>> boneVertices;
+    /** Influences of vertex i are [boneOffsets[i], boneOffsets[i + 1]) in boneIndices, weights and boneVertices / 2. */
+    std::vector<unsigned> boneOffsets;
+    std::vector<unsigned short> boneIndices;
+    std::vector<float> weights;
+    std::vector<float> boneVertices;
 
     std::vector<BoneData*> bones;
     std::vector<Matrix> inverseBindPose;
@@ -121,8 +121,65 @@ void ExtensionFrameData::_onClear()
     TweenFrameData::_onClear();
 
     type = ExtensionType::FFD;
+    runs.clear();
     tweens.clear();
     keys.clear();
 }
 
+void ExtensionFrameData::unionRuns(const std::vector<unsigned>& a, const std::vector<unsigned>& b, std::vector<unsigned>& result)
+{
+    result.clear();
+
+    std::size_t iA = 0;
+    std::size_t iB = 0;
+    const auto lA = a.size();
+    const auto lB = b.size();
+    while (iA < lA || iB < lB)
+    {
+        const auto isA = iB >= lB || (iA < lA && a[iA] <= b[iB]);
+        const auto& runs = isA ? a : b;
+        auto& index = isA ? iA : iB;
+        const auto begin = runs[index];
+        const auto end = runs[index + 1];
+        index += 2;
+
+        if (!result.empty() && begin <= result.back())
+        {
+            result.back() = std::max(result.back(), end);
+        }
+        else
+        {
+            result.push_back(begin);
+            result.push_back(end);
+        }
+    }
+}
+
+void ExtensionFrameData::addTweens(const std::vector<unsigned>& targetRuns, float scale, float* values) const
+{
+    std::size_t iT = 0;
+    std::size_t targetOffset = 0;
+    std::size_t tweenOffset = 0;
+    for (std::size_t i = 0, l = runs.size(); i < l; i += 2)
+    {
+        const auto begin = runs[i];
+        const auto end = runs[i + 1];
+
+        while (targetRuns[iT + 1] < end)
+        {
+            targetOffset += targetRuns[iT + 1] - targetRuns[iT];
+            iT += 2;
+        }
+
+        const auto target = values + targetOffset + (begin - targetRuns[iT]);
+        const auto source = tweens.data() + tweenOffset;
+        for (std::size_t iV = 0, lV = end - begin; iV < lV; ++iV)
+        {
+            target[iV] += source[iV] * scale;
+        }
+
+        tweenOffset += end - begin;
+    }
+}
+
 DRAGONBONES_NAMESPACE_END
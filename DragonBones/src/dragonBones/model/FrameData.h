@@ -105,35 +105,61 @@ template<class T>
 class TweenFrameData : public FrameData<T>
 {
 public:
-    static void samplingCurve(std::vector<float>& curve, unsigned frameCount, std::vector<float>& sampling)
+    static const unsigned CURVE_SAMPLING_COUNT = 32;
+
+    static void samplingCurve(const std::vector<float>& curve, unsigned frameCount, std::vector<float>& sampling)
     {
         if (curve.empty() || frameCount == 0)
         {
             return;
         }
 
-        const auto samplingTimes = frameCount + 2;
-        const auto samplingStep = 1.f / samplingTimes;
-        sampling.reserve((samplingTimes - 1) * 2);
+        std::vector<float> points;
+        points.reserve(curve.size() + 4);
+        points.push_back(0.f);
+        points.push_back(0.f);
+        points.insert(points.end(), curve.cbegin(), curve.cend());
+        points.push_back(1.f);
+        points.push_back(1.f);
 
-        curve.insert(curve.begin(), 0.f);
-        curve.insert(curve.begin(), 0.f);
-        curve.push_back(1.f);
-        curve.push_back(1.f);
+        sampling.resize(CURVE_SAMPLING_COUNT + 1);
+        sampling[0] = 0.f;
+        sampling[CURVE_SAMPLING_COUNT] = 1.f;
 
         std::size_t stepIndex = 0;
-        for (std::size_t i = 0; i < samplingTimes - 1; ++i)
+        for (std::size_t i = 1; i < CURVE_SAMPLING_COUNT; ++i)
         {
-            const auto step = samplingStep * (i + 1);
-            while (curve[stepIndex + 6] < step) // stepIndex + 3 * 2
+            const auto step = (float)i / CURVE_SAMPLING_COUNT;
+            while (stepIndex + 13 < points.size() && points[stepIndex + 6] < step) // stepIndex + 3 * 2
             {
                 stepIndex += 6; // stepIndex += 3 * 2
             }
 
-            const auto x1 = curve[stepIndex];
-            const auto x4 = curve[stepIndex + 6];
+            const auto x1 = points[stepIndex];
+            const auto x2 = points[stepIndex + 2];
+            const auto x3 = points[stepIndex + 4];
+            const auto x4 = points[stepIndex + 6];
+
+            // Find t where x(t) == step, x is monotonic on each segment.
+            auto tA = 0.f;
+            auto tB = 1.f;
+            auto t = x4 > x1 ? (step - x1) / (x4 - x1) : 0.f;
+            for (std::size_t j = 0; j < 16; ++j)
+            {
+                const auto l_t = 1.f - t;
+                const auto x = l_t * l_t * l_t * x1 + 3.f * t * l_t * l_t * x2 + 3.f * t * t * l_t * x3 + t * t * t * x4;
+                if (x < step)
+                {
+                    tA = t;
+                }
+                else
+                {
+                    tB = t;
+                }
+
+                t = (tA + tB) * 0.5f;
+            }
 
-            const auto t = (step - x1) / (x4 - x1);
             const auto l_t = 1.f - t;
 
             const auto powA = l_t * l_t;
@@ -144,13 +170,13 @@ public:
             const auto kC = 3.f * l_t * powB;
             const auto kD = t * powB;
 
-            sampling.push_back(kA * x1 + kB * curve[stepIndex + 2] + kC * curve[stepIndex + 4] + kD * x4);
-            sampling.push_back(kA * curve[stepIndex + 1] + kB * curve[stepIndex + 3] + kC * curve[stepIndex + 5] + kD * curve[stepIndex + 7]);
+            sampling[i] = kA * points[stepIndex + 1] + kB * points[stepIndex + 3] + kC * points[stepIndex + 5] + kD * points[stepIndex + 7];
         }
     }
 
 public:
     float tweenEasing;
+    /** Eased progress at CURVE_SAMPLING_COUNT + 1 evenly spaced points. */
     std::vector<float> curve;
 
     TweenFrameData() {}
@@ -240,8 +266,14 @@ class ExtensionFrameData final : public TweenFrameData<ExtensionFrameData>
 {
     BIND_CLASS_TYPE(ExtensionFrameData);
 
+public:
+    /** Zero gaps shorter than this many values stay inside a run, tweening them is cheaper than another run. */
+    static const unsigned RUN_GAP = 16;
+
 public:
     ExtensionType type;
+    /** Begin and end indices of the deformed runs in ascending order, tweens holds their values back to back. Values outside of the runs are zero. */
+    std::vector<unsigned> runs;
     std::vector<float> tweens;
     std::vector<float> keys;
 
@@ -253,6 +285,13 @@ private:
 
 protected:
     void _onClear() override;
+
+public:
+    /** Merges the runs of a and b, touching or overlapping runs become one. */
+    static void unionRuns(const std::vector<unsigned>& a, const std::vector<unsigned>& b, std::vector<unsigned>& result);
+
+    /** Adds tweens * scale to values laid out by targetRuns, which must cover every run of this frame. */
+    void addTweens(const std::vector<unsigned>& targetRuns, float scale, float* values) const;
 };
 
 DRAGONBONES_NAMESPACE_END
@@ -63,6 +63,113 @@ void BoneTimelineData::cacheFrames(std::size_t cacheFrameCount)
     cachedFrames.resize(cacheFrameCount, nullptr);
 }
 
+bool BoneTimelineData::_isReducible(std::size_t fromIndex, std::size_t toIndex, float tolerance) const
+{
+    const auto fromFrame = frames[fromIndex];
+    const auto toFrame = frames[toIndex];
+    const auto& fromTransform = fromFrame->transform;
+    const auto& toTransform = toFrame->transform;
+    const auto isLinear = fromFrame->tweenEasing == 0.f;
+
+    if (
+        (!isLinear && fromFrame->tweenEasing != NO_TWEEN) || !fromFrame->curve.empty() ||
+        fromFrame->tweenRotate != 0 || fromFrame->duration <= 0.f
+    )
+    {
+        return false;
+    }
+
+    const auto duration = toFrame->position - fromFrame->position;
+    const auto durationSkewX = Transform::normalizeRadian(toTransform.skewX - fromTransform.skewX);
+    const auto durationSkewY = Transform::normalizeRadian(toTransform.skewY - fromTransform.skewY);
+
+    for (std::size_t i = fromIndex + 1; i < toIndex; ++i)
+    {
+        const auto frame = frames[i];
+        if (
+            frame->tweenEasing != fromFrame->tweenEasing || !frame->curve.empty() || frame->duration <= 0.f ||
+            frame->tweenRotate != 0 || frame->tweenScale != fromFrame->tweenScale || frame->parent != fromFrame->parent ||
+            !frame->actions.empty() || !frame->events.empty()
+        )
+        {
+            return false;
+        }
+
+        const auto progress = (isLinear && duration > 0.f) ? (frame->position - fromFrame->position) / duration : 0.f;
+        const auto scaleProgress = fromFrame->tweenScale ? progress : 0.f;
+        const auto& transform = frame->transform;
+
+        if (
+            std::abs(fromTransform.x + (toTransform.x - fromTransform.x) * progress - transform.x) > tolerance ||
+            std::abs(fromTransform.y + (toTransform.y - fromTransform.y) * progress - transform.y) > tolerance ||
+            std::abs(Transform::normalizeRadian(fromTransform.skewX + durationSkewX * progress - transform.skewX)) > tolerance ||
+            std::abs(Transform::normalizeRadian(fromTransform.skewY + durationSkewY * progress - transform.skewY)) > tolerance ||
+            std::abs(fromTransform.scaleX + (toTransform.scaleX - fromTransform.scaleX) * scaleProgress - transform.scaleX) > tolerance ||
+            std::abs(fromTransform.scaleY + (toTransform.scaleY - fromTransform.scaleY) * scaleProgress - transform.scaleY) > tolerance
+        )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void BoneTimelineData::reduceFrames(float tolerance)
+{
+    const auto frameCount = frames.size();
+    if (frameCount < 3 || tolerance <= 0.f)
+    {
+        return;
+    }
+
+    std::vector<bool> isRemoved(frameCount, false);
+    std::size_t fromIndex = 0;
+
+    // The first and last key frames are always kept, the last one tweens back to the first.
+    for (std::size_t i = 1; i < frameCount - 1; ++i)
+    {
+        if (_isReducible(fromIndex, i + 1, tolerance))
+        {
+            isRemoved[i] = true;
+        }
+        else
+        {
+            fromIndex = i;
+        }
+    }
+
+    std::size_t count = 0;
+    BoneFrameData* prevFrame = nullptr;
+    for (std::size_t i = 0; i < frameCount; ++i)
+    {
+        const auto frame = frames[i];
+        if (isRemoved[i])
+        {
+            frame->returnToPool();
+            continue;
+        }
+
+        if (prevFrame && isRemoved[i - 1])
+        {
+            prevFrame->duration = frame->position - prevFrame->position;
+            prevFrame->next = frame;
+            frame->prev = prevFrame;
+        }
+
+        frames[count] = frame;
+        frameStarts[count] = frameStarts[i];
+        prevFrame = frame;
+        count++;
+    }
+
+    frames.resize(count);
+    frameStarts.resize(count);
+
+    prevFrame->next = frames[0];
+    frames[0]->prev = prevFrame;
+}
+
 Matrix* SlotTimelineData::cacheFrame(std::vector<Matrix*>& cacheFrames, std::size_t cacheFrameIndex, const Matrix& globalTransformMatrix)
 {
     const auto cacheMatrix = cacheFrames[cacheFrameIndex] = new Matrix();
@@ -71,6 +178,28 @@ Matrix* SlotTimelineData::cacheFrame(std::vector<Matrix*>& cacheFrames, std::siz
     return cacheMatrix;
 }
 
+SlotCacheFrame* SlotTimelineData::cacheState(std::vector<SlotCacheFrame*>& cacheStates, std::size_t cacheFrameIndex, int displayIndex, const ColorTransform& color)
+{
+    // Only share with direct neighbours, so equal pointers always stay adjacent.
+    const auto prevState = cacheFrameIndex > 0 ? cacheStates[cacheFrameIndex - 1] : nullptr;
+    if (prevState && prevState->equals(displayIndex, color))
+    {
+        return cacheStates[cacheFrameIndex] = prevState;
+    }
+
+    const auto nextState = cacheFrameIndex + 1 < cacheStates.size() ? cacheStates[cacheFrameIndex + 1] : nullptr;
+    if (nextState && nextState->equals(displayIndex, color))
+    {
+        return cacheStates[cacheFrameIndex] = nextState;
+    }
+
+    const auto cacheState = cacheStates[cacheFrameIndex] = new SlotCacheFrame();
+    cacheState->displayIndex = displayIndex;
+    cacheState->color = color; // copy
+
+    return cacheState;
+}
+
 SlotTimelineData::SlotTimelineData()
 {
     _onClear();
@@ -101,6 +230,32 @@ void SlotTimelineData::_onClear()
     }
 
     cachedFrames.clear();
+
+    _clearCachedStates();
+}
+
+void SlotTimelineData::_clearCachedStates()
+{
+    SlotCacheFrame* prevState = nullptr;
+    for (const auto state : cachedStates)
+    {
+        if (state != prevState)
+        {
+            if (prevState)
+            {
+                delete prevState;
+            }
+
+            prevState = state;
+        }
+    }
+
+    if (prevState)
+    {
+        delete prevState;
+    }
+
+    cachedStates.clear();
 }
 
 void SlotTimelineData::cacheFrames(std::size_t cacheFrameCount)
@@ -121,6 +276,9 @@ void SlotTimelineData::cacheFrames(std::size_t cacheFrameCount)
 
     cachedFrames.clear();
     cachedFrames.resize(cacheFrameCount, nullptr);
+
+    _clearCachedStates();
+    cachedStates.resize(cacheFrameCount, nullptr);
 }
 
 FFDTimelineData::FFDTimelineData()
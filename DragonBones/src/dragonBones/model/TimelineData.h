@@ -19,7 +19,10 @@ public:
     float scale;
     float offset;
 
+    /** Key frames only, in time order. */
     std::vector<T*> frames;
+    /** Start frame index of each key frame, parallel to frames. */
+    std::vector<unsigned> frameStarts;
 
     TimelineData() {}
     virtual ~TimelineData() {}
@@ -30,18 +33,74 @@ protected:
         scale = 1.f;
         offset = 0.f;
 
-        T* prevFrame = nullptr;
         for (const auto frame : frames)
         {
-            if (prevFrame && frame != prevFrame)
-            {
-                prevFrame->returnToPool();
-            }
-
-            prevFrame = frame;
+            frame->returnToPool();
         }
 
         frames.clear();
+        frameStarts.clear();
+    }
+
+public:
+    void addFrame(T* frame, unsigned frameStart)
+    {
+        if (frame && (frameStarts.empty() || frameStart > frameStarts.back()))
+        {
+            frames.push_back(frame);
+            frameStarts.push_back(frameStart);
+        }
+        else
+        {
+            DRAGONBONES_ASSERT(false, "Argument error.");
+        }
+    }
+
+    /** Single key frame without actions or events, its state never changes once applied. */
+    inline bool isConstant() const
+    {
+        return frames.size() == 1 && frames[0]->actions.empty() && frames[0]->events.empty();
+    }
+
+    inline T* getFrame(unsigned frameIndex) const
+    {
+        const auto iterator = std::upper_bound(frameStarts.cbegin(), frameStarts.cend(), frameIndex);
+        return frames[iterator == frameStarts.cbegin() ? 0 : (iterator - frameStarts.cbegin() - 1)];
+    }
+};
+
+/**
+ * @private
+ */
+class SlotCacheFrame final
+{
+public:
+    int displayIndex;
+    ColorTransform color;
+
+    SlotCacheFrame():
+        displayIndex(0),
+        color()
+    {
+    }
+    ~SlotCacheFrame() {}
+
+    inline bool equals(int displayIndexValue, const ColorTransform& colorValue) const
+    {
+        return displayIndex == displayIndexValue && colorEquals(colorValue);
+    }
+
+    inline bool colorEquals(const ColorTransform& colorValue) const
+    {
+        return
+            color.alphaMultiplier == colorValue.alphaMultiplier &&
+            color.redMultiplier == colorValue.redMultiplier &&
+            color.greenMultiplier == colorValue.greenMultiplier &&
+            color.blueMultiplier == colorValue.blueMultiplier &&
+            color.alphaOffset == colorValue.alphaOffset &&
+            color.redOffset == colorValue.redOffset &&
+            color.greenOffset == colorValue.greenOffset &&
+            color.blueOffset == colorValue.blueOffset;
     }
 };
 
@@ -66,12 +125,16 @@ public:
 private:
     DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(BoneTimelineData);
 
+    bool _isReducible(std::size_t fromIndex, std::size_t toIndex, float tolerance) const;
+
 protected:
     void _onClear() override;
 
 public:
     /** @private */
     void cacheFrames(std::size_t cacheFrameCount);
+    /** @private */
+    void reduceFrames(float tolerance);
 };
 
 /**
@@ -83,10 +146,13 @@ class SlotTimelineData final : public TimelineData<SlotFrameData>
 
 public:
     static Matrix* cacheFrame(std::vector<Matrix*>& cacheFrames, std::size_t cacheFrameIndex, const Matrix& globalTransformMatrix);
+    static SlotCacheFrame* cacheState(std::vector<SlotCacheFrame*>& cacheStates, std::size_t cacheFrameIndex, int displayIndex, const ColorTransform& color);
 
 public:
     SlotData* slot;
     std::vector<Matrix*> cachedFrames;
+    /** Display index and color per cache frame, adjacent equal frames share one instance. */
+    std::vector<SlotCacheFrame*> cachedStates;
 
     SlotTimelineData();
     ~SlotTimelineData();
@@ -94,6 +160,8 @@ public:
 private:
     DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(SlotTimelineData);
 
+    void _clearCachedStates();
+
 protected:
     void _onClear() override;
 
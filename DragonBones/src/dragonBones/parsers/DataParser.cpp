@@ -269,6 +269,8 @@ ActionType DataParser::_getActionType(const std::string& value)
 }
 
 DataParser::DataParser() :
+    keyFrameTolerance(0.001f),
+
     _data(nullptr),
     _armature(nullptr),
     _skin(nullptr),
@@ -112,6 +112,13 @@ protected:
     static BlendMode _getBlendMode(const std::string& value);
     static ActionType _getActionType(const std::string& value);
 
+public:
+    /**
+     * Bone key frames that tweening reproduces within this tolerance (pixels, radians and scale) are dropped,
+     * 0 keeps all key frames. The default is well below one pixel or one tenth of a degree.
+     */
+    float keyFrameTolerance;
+
 protected:
     DragonBonesData* _data;
     ArmatureData* _armature;
@@ -280,9 +280,13 @@ MeshData * JSONDataParser::_parseMesh(const rapidjson::Value & rawData)
 
     if (mesh->skinned)
     {
-        mesh->boneIndices.resize(numVertices);
-        mesh->weights.resize(numVertices);
-        mesh->boneVertices.resize(numVertices);
+        const auto numWeights = rawData[WEIGHTS].Size();
+        const auto numInfluences = numWeights > numVertices ? (numWeights - numVertices) / 2 : 0;
+        mesh->boneOffsets.reserve(numVertices + 1);
+        mesh->boneIndices.reserve(numInfluences);
+        mesh->weights.reserve(numInfluences);
+        mesh->boneVertices.reserve(numInfluences * 2);
+        mesh->boneOffsets.push_back(0);
 
         if (rawData.HasMember(SLOT_POSE))
         {
@@ -316,7 +320,6 @@ MeshData * JSONDataParser::_parseMesh(const rapidjson::Value & rawData)
     for (std::size_t i = 0, iW = 0, l = rawVertices.Size(); i < l; i += 2)
     {
         const auto iN = i + 1;
-        const auto vertexIndex = i / 2;
 
         auto x = mesh->vertices[i] = rawVertices[i].GetDouble() * this->_armatureScale;
         auto y = mesh->vertices[iN] = rawVertices[iN].GetDouble() * this->_armatureScale;
@@ -327,9 +330,6 @@ MeshData * JSONDataParser::_parseMesh(const rapidjson::Value & rawData)
         {
             const auto &rawWeights = rawData[WEIGHTS];
             const auto numBones = rawWeights[iW].GetUint();
-            auto& indices = mesh->boneIndices[vertexIndex];
-            auto& weights = mesh->weights[vertexIndex];
-            auto& boneVertices = mesh->boneVertices[vertexIndex];
             mesh->slotPose.transformPoint(x, y, _helpPoint);
             x = mesh->vertices[i] = _helpPoint.x;
             y = mesh->vertices[iN] = _helpPoint.y;
@@ -355,12 +355,13 @@ MeshData * JSONDataParser::_parseMesh(const rapidjson::Value & rawData)
 
                 mesh->inverseBindPose[boneIndex].transformPoint(x, y, _helpPoint);
 
-                indices.push_back(boneIndex);
-                weights.push_back(rawWeights[iI + 1].GetDouble());
-                boneVertices.push_back(_helpPoint.x);
-                boneVertices.push_back(_helpPoint.y);
+                mesh->boneIndices.push_back(boneIndex);
+                mesh->weights.push_back(rawWeights[iI + 1].GetDouble());
+                mesh->boneVertices.push_back(_helpPoint.x);
+                mesh->boneVertices.push_back(_helpPoint.y);
             }
 
+            mesh->boneOffsets.push_back((unsigned)mesh->boneIndices.size());
             iW += numBones * 2 + 1;
         }
     }
@@ -437,8 +438,7 @@ AnimationData * JSONDataParser::_parseAnimation(const rapidjson::Value & rawData
             const auto boneTimeline = BaseObject::borrowObject<BoneTimelineData>();
             const auto boneFrame = BaseObject::borrowObject<BoneFrameData>();
             boneTimeline->bone = pair.second;
-            boneTimeline->frames.reserve(1);
-            boneTimeline->frames.push_back(boneFrame);
+            boneTimeline->addFrame(boneFrame, 0);
             animation->addBoneTimeline(boneTimeline);
         }
     }
@@ -462,8 +462,7 @@ AnimationData * JSONDataParser::_parseAnimation(const rapidjson::Value & rawData
                 *slotFrame->color = *pair.second->color; // copy
             }
 
-            slotTimeline->frames.reserve(1);
-            slotTimeline->frames.push_back(slotFrame);
+            slotTimeline->addFrame(slotFrame, 0);
             animation->addSlotTimeline(slotTimeline);
         }
     }
@@ -491,7 +490,7 @@ BoneTimelineData * JSONDataParser::_parseBoneTimeline(const rapidjson::Value& ra
             originTransform = boneFrame->transform; // copy
             boneFrame->transform.identity();
         }
-        else if (prevFrame != frame)
+        else
         {
             boneFrame->transform.minus(originTransform);
         }
@@ -499,6 +498,8 @@ BoneTimelineData * JSONDataParser::_parseBoneTimeline(const rapidjson::Value& ra
         prevFrame = boneFrame;
     }
 
+    timeline->reduceFrames(this->keyFrameTolerance);
+
     if (timeline->scale != 1.f || timeline->offset != 0.f)
     {
         this->_animation->hasAsynchronyTimeline = true;
@@ -619,6 +620,7 @@ SlotFrameData * JSONDataParser::_parseSlotFrame(const rapidjson::Value & rawData
     {
         const auto slot = static_cast<SlotTimelineData*>(this->_timeline)->slot;
         _parseActionData(rawData, frame->actions, slot->parent, slot);
+        this->_animation->hasSlotTimelineEvent = true;
     }
 
     return frame;
@@ -654,10 +656,10 @@ ExtensionFrameData * JSONDataParser::_parseFFDFrame(const rapidjson::Value & raw
             x = _helpPoint.x;
             y = _helpPoint.y;
 
-            const auto& boneIndices = this->_mesh->boneIndices[(std::size_t)(i / 2)];
-            for (const auto boneIndex : boneIndices)
+            const auto vertexIndex = (std::size_t)(i / 2);
+            for (std::size_t iB = this->_mesh->boneOffsets[vertexIndex], lB = this->_mesh->boneOffsets[vertexIndex + 1]; iB < lB; ++iB)
             {
-                this->_mesh->inverseBindPose[boneIndex].transformPoint(x, y, _helpPoint, true);
+                this->_mesh->inverseBindPose[this->_mesh->boneIndices[iB]].transformPoint(x, y, _helpPoint, true);
                 frame->tweens.push_back(_helpPoint.x);
                 frame->tweens.push_back(_helpPoint.y);
             }
@@ -669,6 +671,42 @@ ExtensionFrameData * JSONDataParser::_parseFFDFrame(const rapidjson::Value & raw
         }
     }
 
+    // Keep only the deformed runs.
+    auto& tweens = frame->tweens;
+    auto& runs = frame->runs;
+    std::size_t count = 0;
+    for (std::size_t i = 0, l = tweens.size(); i < l; )
+    {
+        if (tweens[i] == 0.f)
+        {
+            i++;
+            continue;
+        }
+
+        if (!runs.empty() && i - runs.back() < ExtensionFrameData::RUN_GAP)
+        {
+            for (std::size_t iV = runs.back(); iV < i; ++iV)
+            {
+                tweens[count++] = 0.f;
+            }
+        }
+        else
+        {
+            runs.push_back((unsigned)i);
+            runs.push_back((unsigned)i);
+        }
+
+        while (i < l && tweens[i] != 0.f)
+        {
+            tweens[count++] = tweens[i++];
+        }
+
+        runs.back() = (unsigned)i;
+    }
+
+    tweens.resize(count);
+    tweens.shrink_to_fit();
+
     return frame;
 }
 
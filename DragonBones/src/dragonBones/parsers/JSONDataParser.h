@@ -194,12 +194,11 @@ protected:
                     const auto& frameObject = rawFrames[0];
                     const auto frame = frameParser(frameObject, 0, _getNumber(frameObject, DURATION, (unsigned)1));
                     timeline.frames.reserve(1);
-                    timeline.frames.push_back(frame);
+                    timeline.frameStarts.reserve(1);
+                    timeline.addFrame(frame, 0);
                 }
                 else
                 {
-                    timeline.frames.reserve(this->_animation->frameCount + 1);
-
                     unsigned frameStart = 0;
                     unsigned frameCount = 0;
                     T* frame = nullptr;
@@ -213,6 +212,7 @@ protected:
                             frameStart = i;
                             frameCount = _getNumber(frameObject, DURATION, 1);
                             frame = frameParser(frameObject, frameStart, frameCount);
+                            timeline.addFrame(frame, frameStart);
 
                             if (prevFrame)
                             {
@@ -222,8 +222,6 @@ protected:
 
                             prevFrame = frame;
                         }
-
-                        timeline.frames.push_back(frame);
                     }
 
                     frame->duration = this->_animation->duration - frame->position;
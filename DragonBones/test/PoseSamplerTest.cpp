@@ -0,0 +1,267 @@
+/**
+ * Plays a known armature with an IK chain and bones that inherit scale, rotation or translation, and checks that
+ * PoseSampler poses single instances, small batches and batches of whole lane blocks as the live bones were posed.
+ * No framework, returns non-zero on failure.
+ *
+ * From DragonBones/src, COCOS2DX_ROOT/external provides rapidjson as json/:
+ * g++ -std=c++11 -O2 -I. -I$COCOS2DX_ROOT/external ../test/PoseSamplerTest.cpp $(find dragonBones -name '*.cpp') -o PoseSamplerTest -lpthread
+ */
+#include "dragonBones/DragonBonesHeaders.h"
+#include <chrono>
+#include <cstdio>
+
+DRAGONBONES_USING_NAME_SPACE;
+
+namespace
+{
+    /**
+     * body is rotated and scaled, thigh and calf inherit its scale and calf bends them towards foot as a two bone chain.
+     * cape does not inherit scale or rotation, hand does not inherit translation.
+     */
+    const char* DRAGON_BONES_DATA = R"({
+        "name": "Test", "version": "4.5", "frameRate": 24,
+        "armature": [{
+            "name": "test", "type": "Armature", "frameRate": 24,
+            "bone": [
+                { "name": "root" },
+                { "name": "body", "parent": "root", "transform": { "y": -100, "skX": 20, "skY": 20, "scX": 1.4, "scY": 0.8 } },
+                { "name": "thigh", "parent": "body", "length": 80, "transform": { "x": 40, "y": 30, "skX": 80, "skY": 80 } },
+                { "name": "calf", "parent": "thigh", "length": 70, "transform": { "x": 80, "skX": -30, "skY": -30 } },
+                { "name": "foot", "parent": "root", "transform": { "x": 60, "y": 60 } },
+                { "name": "cape", "parent": "body", "inheritScale": false, "inheritRotation": false, "transform": { "x": -20, "y": 10, "skX": 5, "skY": 5 } },
+                { "name": "hand", "parent": "body", "inheritTranslation": false, "transform": { "x": 30, "y": -40, "scX": 0.5 } }
+            ],
+            "ik": [{ "bone": "calf", "target": "foot", "chain": 1, "bendPositive": false, "weight": 0.8 }],
+            "slot": [],
+            "skin": [{ "name": "", "slot": [] }],
+            "animation": [{
+                "name": "walk", "duration": 24, "playTimes": 0,
+                "bone": [
+                    { "name": "body", "frame": [
+                        { "duration": 12, "tweenEasing": 0, "transform": { "skX": 10, "skY": 10, "scX": 1.2 } },
+                        { "duration": 12, "tweenEasing": 0, "transform": { "skX": -15, "skY": -25, "scY": 0.7 } }
+                    ] },
+                    { "name": "foot", "frame": [
+                        { "duration": 12, "tweenEasing": 0, "transform": { "x": -30 } },
+                        { "duration": 12, "tweenEasing": 0, "transform": { "x": 40, "y": -20 } }
+                    ] },
+                    { "name": "cape", "frame": [
+                        { "duration": 8, "tweenEasing": 0.5, "transform": { "skX": 30, "skY": 30 } },
+                        { "duration": 16, "tweenEasing": -0.5, "transform": { "skX": -30, "skY": -30, "scX": 1.5 } }
+                    ] }
+                ]
+            }]
+        }]
+    })";
+
+    class TestDisplay final : public IArmatureDisplayContainer
+    {
+    public:
+        Armature* armature;
+
+        TestDisplay() : armature(nullptr) {}
+        ~TestDisplay() {}
+
+        void _onClear() override
+        {
+            delete this;
+        }
+
+        void _dispatchEvent(EventObject*) override {}
+        bool hasEvent(const std::string&) const override { return false; }
+        void advanceTimeBySelf(bool) override {}
+
+        Armature* getArmature() const override
+        {
+            return armature;
+        }
+
+        Animation& getAnimation() const override
+        {
+            return armature->getAnimation();
+        }
+    };
+
+    class TestFactory final : public BaseFactory
+    {
+    protected:
+        TextureAtlasData* _generateTextureAtlasData(TextureAtlasData* textureAtlasData, void*) const override
+        {
+            return textureAtlasData;
+        }
+
+        Armature* _generateArmature(const BuildArmaturePackage& dataPackage) const override
+        {
+            const auto armature = BaseObject::borrowObject<Armature>();
+            const auto display = new TestDisplay();
+
+            armature->_armatureData = dataPackage.armature;
+            armature->_skinData = dataPackage.skin;
+            armature->_animation = BaseObject::borrowObject<Animation>();
+            armature->_display = display;
+
+            display->armature = armature;
+            armature->_animation->_armature = armature;
+
+            armature->getAnimation().setAnimations(dataPackage.armature->animations);
+
+            return armature;
+        }
+
+        Slot* _generateSlot(const BuildArmaturePackage&, const SlotDisplayDataSet&) const override
+        {
+            return nullptr;
+        }
+    };
+
+    auto isPassed = true;
+
+    bool isClose(const Matrix& matrix, const Matrix& expected)
+    {
+        const auto difference =
+            std::abs(matrix.a - expected.a) + std::abs(matrix.b - expected.b) +
+            std::abs(matrix.c - expected.c) + std::abs(matrix.d - expected.d) +
+            (std::abs(matrix.tx - expected.tx) + std::abs(matrix.ty - expected.ty)) * 0.01f;
+
+        return difference <= 1e-3f;
+    }
+
+    bool isClose(const Transform& global, const Transform& expected)
+    {
+        return
+            std::abs(global.x - expected.x) <= 1e-2f && std::abs(global.y - expected.y) <= 1e-2f &&
+            std::abs(Transform::normalizeRadian(global.skewX - expected.skewX)) <= 1e-4f &&
+            std::abs(Transform::normalizeRadian(global.skewY - expected.skewY)) <= 1e-4f &&
+            std::abs(global.scaleX - expected.scaleX) <= 1e-4f && std::abs(global.scaleY - expected.scaleY) <= 1e-4f;
+    }
+
+    void checkMatrix(const char* message, const std::string& boneName, unsigned step, const Matrix& matrix, const Matrix& expected)
+    {
+        if (!isClose(matrix, expected))
+        {
+            std::printf(
+                "FAIL %s %s step %u: %f %f %f %f %f %f, expected %f %f %f %f %f %f\n", message, boneName.c_str(), step,
+                matrix.a, matrix.b, matrix.c, matrix.d, matrix.tx, matrix.ty,
+                expected.a, expected.b, expected.c, expected.d, expected.tx, expected.ty
+            );
+            isPassed = false;
+        }
+    }
+
+    void checkGlobal(const char* message, const std::string& boneName, unsigned step, const Transform& global, const Transform& expected)
+    {
+        if (!isClose(global, expected))
+        {
+            std::printf(
+                "FAIL %s %s step %u: %f %f %f %f %f %f, expected %f %f %f %f %f %f\n", message, boneName.c_str(), step,
+                global.x, global.y, global.skewX, global.skewY, global.scaleX, global.scaleY,
+                expected.x, expected.y, expected.skewX, expected.skewY, expected.scaleX, expected.scaleY
+            );
+            isPassed = false;
+        }
+    }
+
+    template<class F>
+    double measure(unsigned repeatCount, const F& kernel)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < repeatCount; ++i)
+        {
+            kernel();
+        }
+
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeatCount;
+    }
+}
+
+int main()
+{
+    TestFactory factory;
+    const auto dragonBonesData = factory.parseDragonBonesData(DRAGON_BONES_DATA);
+    const auto armature = factory.buildArmature("test");
+    if (!dragonBonesData || !armature)
+    {
+        std::printf("FAIL build armature\nFAILED\n");
+        return 1;
+    }
+
+    auto& armatureData = *dragonBonesData->getArmature("test");
+    const auto& animationData = *armatureData.getAnimation("walk");
+    PoseSampler sampler(armatureData);
+    PoseSamplerScratch scratch;
+    const auto boneCount = sampler.getBoneCount();
+    const auto& bones = sampler.getBones();
+
+    if (boneCount != armature->getBones().size() || sampler.getBoneIndex("calf") < 0)
+    {
+        std::printf("FAIL sampler bones\nFAILED\n");
+        return 1;
+    }
+
+    // Past the first play of the loop, whole lane blocks and a partial one.
+    const unsigned stepCount = PoseSamplerScratch::LANE_COUNT * 6 + 5;
+    const auto stepTime = 1.f / 30.f;
+    std::vector<float> times(stepCount);
+    std::vector<Matrix> expectedMatrices(boneCount * stepCount);
+    std::vector<Transform> expectedGlobals(boneCount * stepCount);
+
+    armature->getAnimation().play("walk");
+    for (unsigned i = 0; i < stepCount; ++i)
+    {
+        armature->advanceTime(stepTime);
+        times[i] = (i + 1) * stepTime;
+
+        for (std::size_t k = 0; k < boneCount; ++k)
+        {
+            const auto bone = armature->getBone(bones[k]->name);
+            expectedMatrices[k * stepCount + i] = *bone->globalTransformMatrix;
+            expectedGlobals[k * stepCount + i] = bone->global;
+        }
+    }
+
+    // One instance at a time, matrices only then global transforms only.
+    std::vector<Matrix> matrices(boneCount);
+    std::vector<Transform> globals(boneCount);
+    for (unsigned i = 0; i < stepCount; ++i)
+    {
+        sampler.sample(animationData, times[i], matrices.data(), nullptr, scratch);
+        sampler.sample(animationData, times[i], nullptr, globals.data(), scratch);
+
+        for (std::size_t k = 0; k < boneCount; ++k)
+        {
+            checkMatrix("single matrix", bones[k]->name, i, matrices[k], expectedMatrices[k * stepCount + i]);
+            checkGlobal("single global", bones[k]->name, i, globals[k], expectedGlobals[k * stepCount + i]);
+        }
+    }
+
+    // Batches below, at and past the lane count, each starting at a different step.
+    const std::size_t batchCounts[] = { 2, PoseSamplerScratch::BATCH_COUNT_MIN, 7, PoseSamplerScratch::LANE_COUNT, stepCount };
+    for (const auto count : batchCounts)
+    {
+        const auto first = stepCount - count;
+        matrices.resize(boneCount * count);
+        globals.resize(boneCount * count);
+        sampler.sample(animationData, times.data() + first, count, matrices.data(), globals.data(), scratch);
+
+        for (std::size_t k = 0; k < boneCount; ++k)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto step = (unsigned)(first + i);
+                checkMatrix("batch matrix", bones[k]->name, step, matrices[k * count + i], expectedMatrices[k * stepCount + step]);
+                checkGlobal("batch global", bones[k]->name, step, globals[k * count + i], expectedGlobals[k * stepCount + step]);
+            }
+        }
+    }
+
+    const unsigned repeatCount = 20000;
+    const auto singleTime = measure(repeatCount, [&]() { sampler.sample(animationData, times[0], matrices.data(), nullptr, scratch); });
+    const auto batchTime = measure(repeatCount / stepCount, [&]() { sampler.sample(animationData, times.data(), stepCount, matrices.data(), nullptr, scratch); });
+    std::printf("%u bones: single %.3f us, batch of %u %.3f us per instance\n", (unsigned)boneCount, singleTime, stepCount, batchTime / stepCount);
+
+    armature->dispose();
+
+    std::printf(isPassed ? "PASSED\n" : "FAILED\n");
+
+    return isPassed ? 0 : 1;
+}
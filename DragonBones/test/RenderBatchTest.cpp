@@ -0,0 +1,293 @@
+/**
+ * Builds a known armature without a renderer and checks the batches, vertices and indices RenderBatchBuilder emits.
+ * No framework, returns non-zero on failure.
+ *
+ * From DragonBones/src, COCOS2DX_ROOT/external provides rapidjson as json/:
+ * g++ -std=c++11 -O2 -I. -I$COCOS2DX_ROOT/external ../test/RenderBatchTest.cpp $(find dragonBones -name '*.cpp') -o RenderBatchTest -lpthread
+ */
+#include "dragonBones/DragonBonesHeaders.h"
+#include <cstdio>
+
+DRAGONBONES_USING_NAME_SPACE;
+
+namespace
+{
+    /**
+     * Slots 0 to 2 share the atlas and the normal blend mode, slot 3 is additive.
+     * Slot 2 is a four vertex mesh of two triangles, the others are images.
+     */
+    const char* DRAGON_BONES_DATA = R"({
+        "name": "Test", "version": "4.5", "frameRate": 24,
+        "armature": [{
+            "name": "test", "type": "Armature", "frameRate": 24,
+            "bone": [{ "name": "root" }, { "name": "arm", "parent": "root", "transform": { "x": 100, "y": 50 } }],
+            "slot": [
+                { "name": "a", "parent": "root", "z": 0 },
+                { "name": "b", "parent": "arm", "z": 1 },
+                { "name": "m", "parent": "arm", "z": 2 },
+                { "name": "c", "parent": "root", "z": 3, "blendMode": "add" }
+            ],
+            "skin": [{ "name": "", "slot": [
+                { "name": "a", "display": [{ "type": "image", "name": "a" }] },
+                { "name": "b", "display": [{ "type": "image", "name": "b" }] },
+                { "name": "m", "display": [{
+                    "type": "mesh", "name": "m", "width": 20, "height": 20,
+                    "vertices": [-10, -10, 10, -10, 10, 10, -10, 10],
+                    "uvs": [0, 0, 1, 0, 1, 1, 0, 1],
+                    "triangles": [0, 1, 2, 2, 3, 0],
+                    "edges": [0, 1, 1, 2, 2, 3, 3, 0]
+                }] },
+                { "name": "c", "display": [{ "type": "image", "name": "c" }] }
+            ] }],
+            "animation": [{ "name": "idle", "duration": 1 }]
+        }]
+    })";
+
+    const char* TEXTURE_ATLAS_DATA = R"({
+        "name": "Test", "imagePath": "test.png",
+        "SubTexture": [
+            { "name": "a", "x": 0, "y": 0, "width": 16, "height": 16 },
+            { "name": "b", "x": 10, "y": 20, "width": 30, "height": 40 },
+            { "name": "m", "x": 64, "y": 0, "width": 32, "height": 32 },
+            { "name": "c", "x": 0, "y": 64, "width": 8, "height": 8 }
+        ]
+    })";
+
+    class TestDisplay final : public IArmatureDisplayContainer
+    {
+    public:
+        Armature* armature;
+
+        TestDisplay() : armature(nullptr) {}
+        ~TestDisplay() {}
+
+        void _onClear() override
+        {
+            delete this;
+        }
+
+        void _dispatchEvent(EventObject*) override {}
+        bool hasEvent(const std::string&) const override { return false; }
+        void advanceTimeBySelf(bool) override {}
+
+        Armature* getArmature() const override
+        {
+            return armature;
+        }
+
+        Animation& getAnimation() const override
+        {
+            return armature->getAnimation();
+        }
+    };
+
+    class TestSlot final : public Slot
+    {
+        BIND_CLASS_TYPE(TestSlot);
+
+    public:
+        TestSlot() { _onClear(); }
+        ~TestSlot() { _onClear(); }
+
+    protected:
+        void _initDisplay(void*) override {}
+        void _onUpdateDisplay() override {}
+        void _addDisplay() override {}
+        void _replaceDisplay(void*, bool) override {}
+        void _removeDisplay() override {}
+        void _disposeDisplay(void*) override {}
+        void _updateColor() override {}
+        void _updateFilters() override {}
+        void _updateFrame() override {}
+        void _updateMesh() override {}
+        void _updateTransform() override {}
+
+    public:
+        void _updateVisible() override {}
+        void _updateBlendMode() override {}
+    };
+
+    class TestTextureData final : public TextureData
+    {
+        BIND_CLASS_TYPE(TestTextureData);
+
+    public:
+        TestTextureData() { _onClear(); }
+        ~TestTextureData() { _onClear(); }
+    };
+
+    class TestTextureAtlasData final : public TextureAtlasData
+    {
+        BIND_CLASS_TYPE(TestTextureAtlasData);
+
+    public:
+        TestTextureAtlasData() { _onClear(); }
+        ~TestTextureAtlasData() { _onClear(); }
+
+        TextureData* generateTexture() const override
+        {
+            return BaseObject::borrowObject<TestTextureData>();
+        }
+    };
+
+    class TestFactory final : public BaseFactory
+    {
+    protected:
+        TextureAtlasData* _generateTextureAtlasData(TextureAtlasData* textureAtlasData, void*) const override
+        {
+            return textureAtlasData ? textureAtlasData : BaseObject::borrowObject<TestTextureAtlasData>();
+        }
+
+        Armature* _generateArmature(const BuildArmaturePackage& dataPackage) const override
+        {
+            const auto armature = BaseObject::borrowObject<Armature>();
+            const auto display = new TestDisplay();
+
+            armature->_armatureData = dataPackage.armature;
+            armature->_skinData = dataPackage.skin;
+            armature->_animation = BaseObject::borrowObject<Animation>();
+            armature->_display = display;
+
+            display->armature = armature;
+            armature->_animation->_armature = armature;
+
+            armature->getAnimation().setAnimations(dataPackage.armature->animations);
+
+            return armature;
+        }
+
+        Slot* _generateSlot(const BuildArmaturePackage& dataPackage, const SlotDisplayDataSet& slotDisplayDataSet) const override
+        {
+            static int rawDisplay = 0;
+            const auto slot = BaseObject::borrowObject<TestSlot>();
+            std::vector<std::pair<void*, DisplayType>> displayList;
+
+            slot->name = slotDisplayDataSet.slot->name;
+            slot->_rawDisplay = &rawDisplay;
+            slot->_meshDisplay = &rawDisplay;
+
+            for (const auto displayData : slotDisplayDataSet.displays)
+            {
+                if (!displayData->textureData)
+                {
+                    displayData->textureData = this->_getTextureData(dataPackage.dataName, displayData->name);
+                }
+
+                displayList.push_back(std::make_pair(slot->_rawDisplay, displayData->type));
+            }
+
+            slot->_setDisplayList(displayList);
+
+            return slot;
+        }
+    };
+
+    auto isPassed = true;
+
+    void check(bool value, const char* message, unsigned actual, unsigned expected)
+    {
+        if (!value)
+        {
+            std::printf("FAIL %s: %u, expected %u\n", message, actual, expected);
+            isPassed = false;
+        }
+    }
+
+    void checkCount(const char* message, std::size_t actual, std::size_t expected)
+    {
+        check(actual == expected, message, (unsigned)actual, (unsigned)expected);
+    }
+}
+
+int main()
+{
+    TestFactory factory;
+    factory.parseDragonBonesData(DRAGON_BONES_DATA);
+    factory.parseTextureAtlasData(TEXTURE_ATLAS_DATA, nullptr);
+
+    const auto armatureA = factory.buildArmature("test");
+    const auto armatureB = factory.buildArmature("test");
+    if (!armatureA || !armatureB)
+    {
+        std::printf("FAIL build armature\nFAILED\n");
+        return 1;
+    }
+
+    armatureA->advanceTime(0.f);
+    armatureB->advanceTime(0.f);
+
+    RenderBatchBuilder builder;
+    Matrix transform;
+
+    // One armature: three slots in one normal batch, the additive slot in a second batch.
+    builder.addArmature(*armatureA, transform);
+
+    checkCount("batch count", builder.batches.size(), 2);
+    checkCount("vertex count", builder.vertices.size(), 4 + 4 + 4 + 4);
+    checkCount("index count", builder.indices.size(), 6 + 6 + 6 + 6);
+
+    if (builder.batches.size() == 2)
+    {
+        const auto& normalBatch = builder.batches[0];
+        const auto& addBatch = builder.batches[1];
+        check(normalBatch.blendMode == BlendMode::Normal, "first batch blend mode", (unsigned)normalBatch.blendMode, (unsigned)BlendMode::Normal);
+        check(addBatch.blendMode == BlendMode::Add, "second batch blend mode", (unsigned)addBatch.blendMode, (unsigned)BlendMode::Add);
+        checkCount("first batch vertex start", normalBatch.vertexStart, 0);
+        checkCount("first batch vertex count", normalBatch.vertexCount, 12);
+        checkCount("first batch index count", normalBatch.indexCount, 18);
+        checkCount("second batch vertex start", addBatch.vertexStart, 12);
+        checkCount("second batch vertex count", addBatch.vertexCount, 4);
+        checkCount("second batch index start", addBatch.indexStart, 18);
+        checkCount("second batch index count", addBatch.indexCount, 6);
+        check(normalBatch.armature == armatureA, "batch armature", 0, 0);
+    }
+
+    if (builder.vertices.size() == 16 && builder.indices.size() == 24)
+    {
+        // Image b, top left then bottom right, uv in atlas pixels.
+        const auto& topLeft = builder.vertices[4];
+        const auto& bottomRight = builder.vertices[6];
+        checkCount("image b top left u", (std::size_t)topLeft.u, 10);
+        checkCount("image b top left v", (std::size_t)topLeft.v, 20);
+        checkCount("image b bottom right u", (std::size_t)bottomRight.u, 40);
+        checkCount("image b bottom right v", (std::size_t)bottomRight.v, 60);
+
+        // Mesh m, moved by its bone, uvs mapped into the region.
+        const auto& meshVertex = builder.vertices[8];
+        checkCount("mesh x", (std::size_t)meshVertex.x, 90);
+        checkCount("mesh y", (std::size_t)meshVertex.y, 40);
+        checkCount("mesh last u", (std::size_t)builder.vertices[11].u, 64);
+        checkCount("mesh last v", (std::size_t)builder.vertices[11].v, 32);
+
+        // Indices are relative to the batch, the mesh follows the two quads.
+        const unsigned short expectedIndices[] = {
+            0, 1, 2, 2, 3, 0,
+            4, 5, 6, 6, 7, 4,
+            8, 9, 10, 10, 11, 8,
+            0, 1, 2, 2, 3, 0
+        };
+        for (std::size_t i = 0; i < 24; ++i)
+        {
+            checkCount("index", builder.indices[i], expectedIndices[i]);
+        }
+    }
+
+    // A second armature never merges into the batches of the first.
+    builder.addArmature(*armatureB, transform);
+
+    checkCount("two armatures batch count", builder.batches.size(), 4);
+    checkCount("two armatures vertex count", builder.vertices.size(), 32);
+    checkCount("two armatures index count", builder.indices.size(), 48);
+
+    // clear() keeps nothing.
+    builder.clear();
+    checkCount("cleared batch count", builder.batches.size(), 0);
+    checkCount("cleared vertex count", builder.vertices.size(), 0);
+
+    armatureA->dispose();
+    armatureB->dispose();
+
+    std::printf(isPassed ? "PASSED\n" : "FAILED\n");
+
+    return isPassed ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+/**
+ * Checks Slot::_skinVertices() and Slot::_getVerticesBounds() against the skinning loop CCSlot::_updateMesh() used
+ * before skinning moved into the core library, and times the kernels. No framework, returns non-zero on failure.
+ *
+ * From DragonBones/src, without and with the SIMD kernels, COCOS2DX_ROOT/external provides rapidjson as json/:
+ * g++ -std=c++11 -O2 -I. -I$COCOS2DX_ROOT/external ../test/SkinningTest.cpp $(find dragonBones -name '*.cpp') -o SkinningTest -lpthread
+ * g++ -std=c++11 -O2 -mavx2 -I. -I$COCOS2DX_ROOT/external ../test/SkinningTest.cpp $(find dragonBones -name '*.cpp') -o SkinningTest -lpthread
+ */
+#include "dragonBones/DragonBonesHeaders.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+DRAGONBONES_USING_NAME_SPACE;
+
+namespace
+{
+    /** Per vertex influences as CCSlot::_updateMesh() read them, before they were flattened into rows. */
+    class ReferenceMesh
+    {
+    public:
+        std::vector<std::vector<unsigned short>> boneIndices;
+        std::vector<std::vector<float>> boneVertices;
+        std::vector<std::vector<float>> weights;
+    };
+
+    void referenceSkin(const ReferenceMesh& mesh, const std::vector<Bone*>& meshBones, const std::vector<float>& ffdVertices, std::vector<float>& vertices, Rectangle& bounds)
+    {
+        const auto hasFFD = !ffdVertices.empty();
+        auto minX = 999999.f;
+        auto minY = 999999.f;
+        auto maxX = -999999.f;
+        auto maxY = -999999.f;
+
+        vertices.resize(mesh.boneIndices.size() * 2);
+
+        std::size_t iF = 0;
+        for (std::size_t iH = 0, l = mesh.boneIndices.size(); iH < l; ++iH)
+        {
+            const auto& boneIndices = mesh.boneIndices[iH];
+            const auto& boneVertices = mesh.boneVertices[iH];
+            const auto& weights = mesh.weights[iH];
+
+            float xG = 0.f, yG = 0.f;
+            for (std::size_t iB = 0, lB = boneIndices.size(); iB < lB; ++iB)
+            {
+                const auto matrix = meshBones[boneIndices[iB]]->globalTransformMatrix;
+                const auto weight = weights[iB];
+
+                float xL = 0.f, yL = 0.f;
+                if (hasFFD)
+                {
+                    xL = boneVertices[iB * 2] + ffdVertices[iF];
+                    yL = boneVertices[iB * 2 + 1] + ffdVertices[iF + 1];
+                }
+                else
+                {
+                    xL = boneVertices[iB * 2];
+                    yL = boneVertices[iB * 2 + 1];
+                }
+
+                xG += (matrix->a * xL + matrix->c * yL + matrix->tx) * weight;
+                yG += (matrix->b * xL + matrix->d * yL + matrix->ty) * weight;
+
+                iF += 2;
+            }
+
+            vertices[iH * 2] = xG;
+            vertices[iH * 2 + 1] = yG;
+
+            if (minX > xG)
+            {
+                minX = xG;
+            }
+
+            if (maxX < xG)
+            {
+                maxX = xG;
+            }
+
+            if (minY > yG)
+            {
+                minY = yG;
+            }
+
+            if (maxY < yG)
+            {
+                maxY = yG;
+            }
+        }
+
+        bounds.x = minX;
+        bounds.y = minY;
+        bounds.width = maxX - minX;
+        bounds.height = maxY - minY;
+    }
+
+    void buildMesh(std::mt19937& random, std::size_t vertexCount, std::size_t boneCount, MeshData& meshData, ReferenceMesh& referenceMesh)
+    {
+        std::uniform_real_distribution<float> position(-200.f, 200.f);
+        std::uniform_real_distribution<float> weight(0.05f, 1.f);
+        std::uniform_int_distribution<unsigned> influenceCount(1, 5);
+        std::uniform_int_distribution<unsigned> bone(0, boneCount - 1);
+
+        meshData.skinned = true;
+        meshData.boneOffsets.push_back(0);
+
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            referenceMesh.boneIndices.resize(i + 1);
+            referenceMesh.boneVertices.resize(i + 1);
+            referenceMesh.weights.resize(i + 1);
+
+            const auto count = influenceCount(random);
+            auto weightSum = 0.f;
+            std::vector<float> weights;
+            for (unsigned iB = 0; iB < count; ++iB)
+            {
+                weights.push_back(weight(random));
+                weightSum += weights.back();
+            }
+
+            for (unsigned iB = 0; iB < count; ++iB)
+            {
+                const auto boneIndex = (unsigned short)bone(random);
+                const auto x = position(random);
+                const auto y = position(random);
+                const auto w = weights[iB] / weightSum;
+
+                meshData.boneIndices.push_back(boneIndex);
+                meshData.boneVertices.push_back(x);
+                meshData.boneVertices.push_back(y);
+                meshData.weights.push_back(w);
+
+                referenceMesh.boneIndices[i].push_back(boneIndex);
+                referenceMesh.boneVertices[i].push_back(x);
+                referenceMesh.boneVertices[i].push_back(y);
+                referenceMesh.weights[i].push_back(w);
+            }
+
+            meshData.boneOffsets.push_back((unsigned)meshData.boneIndices.size());
+        }
+    }
+
+    bool isClose(float a, float b)
+    {
+        return std::abs(a - b) <= 1e-3f + std::abs(b) * 1e-5f;
+    }
+
+    bool compare(const char* name, const std::vector<float>& vertices, const Rectangle& bounds, const std::vector<float>& referenceVertices, const Rectangle& referenceBounds)
+    {
+        for (std::size_t i = 0, l = referenceVertices.size(); i < l; ++i)
+        {
+            if (!isClose(vertices[i], referenceVertices[i]))
+            {
+                std::printf("FAIL %s vertex %u: %f, expected %f\n", name, (unsigned)(i / 2), vertices[i], referenceVertices[i]);
+                return false;
+            }
+        }
+
+        if (
+            !isClose(bounds.x, referenceBounds.x) || !isClose(bounds.y, referenceBounds.y) ||
+            !isClose(bounds.width, referenceBounds.width) || !isClose(bounds.height, referenceBounds.height)
+        )
+        {
+            std::printf(
+                "FAIL %s bounds: %f %f %f %f, expected %f %f %f %f\n", name,
+                bounds.x, bounds.y, bounds.width, bounds.height,
+                referenceBounds.x, referenceBounds.y, referenceBounds.width, referenceBounds.height
+            );
+            return false;
+        }
+
+        return true;
+    }
+
+    template<class F>
+    double measure(unsigned repeatCount, const F& kernel)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < repeatCount; ++i)
+        {
+            kernel();
+        }
+
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeatCount;
+    }
+}
+
+int main()
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    auto isPassed = true;
+
+    std::printf("SIMD kernels: %s\n", DRAGONBONES_SIMD ? "on" : "off");
+
+    const std::size_t vertexCounts[] = { 1, 2, 3, 4, 5, 7, 8, 9, 31, 200, 4096 };
+    for (const auto vertexCount : vertexCounts)
+    {
+        const std::size_t boneCount = 12;
+        std::vector<Bone*> bones;
+        for (std::size_t i = 0; i < boneCount; ++i)
+        {
+            const auto bone = BaseObject::borrowObject<Bone>();
+            Transform transform;
+            transform.x = unit(random) * 300.f;
+            transform.y = unit(random) * 300.f;
+            transform.skewX = unit(random) * 3.f;
+            transform.skewY = transform.skewX + unit(random) * 0.2f;
+            transform.scaleX = 1.f + unit(random) * 0.5f;
+            transform.scaleY = 1.f + unit(random) * 0.5f;
+            transform.toMatrix(*bone->globalTransformMatrix);
+            bones.push_back(bone);
+        }
+
+        const auto meshData = BaseObject::borrowObject<MeshData>();
+        ReferenceMesh referenceMesh;
+        buildMesh(random, vertexCount, boneCount, *meshData, referenceMesh);
+
+        std::vector<float> ffdVertices(meshData->boneVertices.size());
+        for (auto& value : ffdVertices)
+        {
+            value = unit(random) * 10.f;
+        }
+
+        for (unsigned hasFFD = 0; hasFFD < 2; ++hasFFD)
+        {
+            const auto& ffd = hasFFD ? ffdVertices : std::vector<float>();
+            const auto ffdData = hasFFD ? ffdVertices.data() : nullptr;
+            std::vector<float> referenceVertices;
+            std::vector<float> vertices(vertexCount * 2);
+            std::vector<float> scalarVertices(vertexCount * 2);
+            Rectangle referenceBounds;
+            Rectangle bounds;
+            Rectangle scalarBounds;
+
+            referenceSkin(referenceMesh, bones, ffd, referenceVertices, referenceBounds);
+
+            Slot::_skinVertices(*meshData, bones, ffdData, vertices.data());
+            Slot::_getVerticesBounds(vertices.data(), vertexCount, bounds);
+            Slot::_skinVerticesScalar(*meshData, bones, ffdData, scalarVertices.data());
+            Slot::_getVerticesBounds(scalarVertices.data(), vertexCount, scalarBounds);
+
+            isPassed = compare("kernel", vertices, bounds, referenceVertices, referenceBounds) && isPassed;
+            isPassed = compare("scalar kernel", scalarVertices, scalarBounds, referenceVertices, referenceBounds) && isPassed;
+
+            if (vertexCount == 4096)
+            {
+                const unsigned repeatCount = 2000;
+                const auto referenceTime = measure(repeatCount, [&]() { referenceSkin(referenceMesh, bones, ffd, referenceVertices, referenceBounds); });
+                const auto scalarTime = measure(repeatCount, [&]() {
+                    Slot::_skinVerticesScalar(*meshData, bones, ffdData, scalarVertices.data());
+                    Slot::_getVerticesBounds(scalarVertices.data(), vertexCount, scalarBounds);
+                });
+                const auto kernelTime = measure(repeatCount, [&]() {
+                    Slot::_skinVertices(*meshData, bones, ffdData, vertices.data());
+                    Slot::_getVerticesBounds(vertices.data(), vertexCount, bounds);
+                });
+
+                std::printf(
+                    "%u vertices%s: reference %.1f us, scalar %.1f us, kernel %.1f us\n",
+                    (unsigned)vertexCount, hasFFD ? " with FFD" : "", referenceTime, scalarTime, kernelTime
+                );
+            }
+        }
+
+        meshData->returnToPool();
+        for (const auto bone : bones)
+        {
+            bone->returnToPool();
+        }
+    }
+
+    std::printf(isPassed ? "PASSED\n" : "FAILED\n");
+
+    return isPassed ? 0 : 1;
+}